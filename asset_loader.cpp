@@ -0,0 +1,135 @@
+#include "asset_loader.h"
+#include "job_system.h"
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+    double LoaderClock() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+AssetLoader::AssetLoader(JobSystem& jobs) : jobs_(jobs) {
+}
+
+AssetLoader::~AssetLoader() {
+    if (thread_.joinable()) thread_.join();
+    for (Asset& asset : assets_) {
+        if (!asset.uploaded && asset.image.data != nullptr) UnloadImage(asset.image);
+        if (!asset.uploaded && asset.source != nullptr) UnloadFileText(asset.source);
+    }
+}
+
+int AssetLoader::addTexture(const char* path) {
+    const std::string file = path;
+    return addGeneratedTexture(path, [file]() { return LoadImage(file.c_str()); });
+}
+
+int AssetLoader::addGeneratedTexture(const char* name, const std::function<Image()>& generate) {
+    Asset asset;
+    asset.name = name;
+    asset.generate = generate;
+    assets_.push_back(asset);
+    return static_cast<int>(assets_.size()) - 1;
+}
+
+int AssetLoader::addFragmentShader(const char* path) {
+    Asset asset;
+    asset.name = path;
+    asset.isShader = true;
+    assets_.push_back(asset);
+    return static_cast<int>(assets_.size()) - 1;
+}
+
+void AssetLoader::decode(const int index) {
+    if (cancelled_.load(std::memory_order_relaxed)) return;
+    Asset& asset = assets_[index];
+    const double start = LoaderClock();
+    if (asset.isShader) {
+        asset.source = LoadFileText(asset.name.c_str());
+    } else {
+        asset.image = asset.generate();
+    }
+    asset.decodeMs = (LoaderClock() - start) * 1000.0;
+    decoded_[index].store(true, std::memory_order_release);
+}
+
+void AssetLoader::start() {
+    startTime_ = LoaderClock();
+    const int count = static_cast<int>(assets_.size());
+    decoded_.reset(new std::atomic<bool>[count]);
+    for (int i = 0; i < count; ++i) decoded_[i].store(false);
+
+    // One asset per chunk: they differ wildly in size, so stealing balances the big ones across threads
+    thread_ = std::thread([this, count]() {
+        jobs_.parallelFor(count, 1, [this](const int begin, const int end) {
+            for (int i = begin; i < end; ++i) decode(i);
+        });
+    });
+}
+
+bool AssetLoader::uploadReady() {
+    for (int i = 0; i < static_cast<int>(assets_.size()); ++i) {
+        Asset& asset = assets_[i];
+        if (asset.uploaded || !decoded_[i].load(std::memory_order_acquire)) continue;
+
+        const double start = LoaderClock();
+        if (asset.isShader) {
+            asset.shader = LoadShaderFromMemory(nullptr, asset.source);
+            UnloadFileText(asset.source);
+            asset.source = nullptr;
+        } else {
+            asset.texture = LoadTextureFromImage(asset.image);
+            UnloadImage(asset.image);
+            asset.image = Image{};
+        }
+        asset.uploadMs = (LoaderClock() - start) * 1000.0;
+        asset.uploaded = true;
+        ++uploadedCount_;
+    }
+
+    const bool done = uploadedCount_ == static_cast<int>(assets_.size());
+    if (done && thread_.joinable()) {
+        thread_.join();
+        loadMs_ = (LoaderClock() - startTime_) * 1000.0;
+    }
+    return done;
+}
+
+void AssetLoader::cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) thread_.join();
+    for (Asset& asset : assets_) {
+        if (!asset.uploaded) continue;
+        if (asset.isShader) {
+            UnloadShader(asset.shader);
+            asset.shader = Shader{};
+        } else {
+            UnloadTexture(asset.texture);
+            asset.texture = Texture2D{};
+        }
+    }
+}
+
+float AssetLoader::progress() const {
+    return assets_.empty() ? 1.0f : static_cast<float>(uploadedCount_) / assets_.size();
+}
+
+Texture2D AssetLoader::texture(const int asset) const {
+    return assets_[asset].texture;
+}
+
+Shader AssetLoader::shader(const int asset) const {
+    return assets_[asset].shader;
+}
+
+void AssetLoader::report(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2);
+    for (const Asset& asset : assets_) {
+        out << "  " << std::left << std::setw(28) << asset.name << std::right
+            << " decode " << std::setw(8) << asset.decodeMs << " ms, upload " << std::setw(7) << asset.uploadMs
+            << " ms" << std::endl;
+    }
+    out << "  assets loaded in " << loadMs_ << " ms" << std::endl;
+}
@@ -0,0 +1,75 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include "raylib.h"
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+// Startup assets loaded off the main thread. Everything that only needs the CPU (decoding images, generating them,
+// reading shader source) runs in parallel on the job system, driven from a loader thread so the main thread is free
+// to draw a loading screen. Only the GPU side (texture upload, shader compile) happens on the main thread, in
+// uploadReady. The loader hands out the GPU objects and does not own them; unload them as usual.
+class AssetLoader {
+public:
+    explicit AssetLoader(JobSystem& jobs);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Queue an asset before start(); the returned index is what texture()/shader() take
+    int addTexture(const char* path);
+    int addGeneratedTexture(const char* name, const std::function<Image()>& generate);
+    int addFragmentShader(const char* path);
+
+    void start();
+    // Uploads whatever has been decoded since the last call. Main thread only. Returns true once every asset is on
+    // the GPU, at which point the loader thread has finished and the job system is free again.
+    bool uploadReady();
+    // Share of the assets on the GPU, 0..1
+    float progress() const;
+    // Gives up on the load, e.g. when the window is closed during startup: assets not yet decoding are skipped, the
+    // loader thread is joined and everything already on the GPU is unloaded. Main thread only; nothing can be
+    // taken from the loader afterwards.
+    void cancel();
+
+    Texture2D texture(int asset) const;
+    Shader shader(int asset) const;
+
+    // One line per asset with its decode and upload time, then the wall time from start() to the last upload
+    void report(std::ostream& out) const;
+
+private:
+    struct Asset {
+        std::string name;
+        std::function<Image()> generate;        // textures
+        bool isShader = false;
+        Image image = {};
+        char* source = nullptr;                 // shaders
+        Texture2D texture = {};
+        Shader shader = {};
+        double decodeMs = 0.0;
+        double uploadMs = 0.0;
+        bool uploaded = false;
+    };
+
+    void decode(int asset);
+
+    JobSystem& jobs_;
+    std::vector<Asset> assets_;
+    std::unique_ptr<std::atomic<bool>[]> decoded_;
+    std::atomic<bool> cancelled_{false};
+    std::thread thread_;
+    int uploadedCount_ = 0;
+    double startTime_ = 0.0;
+    double loadMs_ = 0.0;                       // start() to the last upload
+};
+
+#endif //ASSET_LOADER_H
@@ -0,0 +1,141 @@
+#include "audio_engine.h"
+#include "karplus_strong.h"
+#include "spsc_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace {
+    struct NoteEvent {
+        int string;
+        float frequency;
+        float velocity;
+        float position;
+        double time;                // AudioClock() of the input that plucked it
+    };
+
+    struct ScheduledNote {
+        NoteEvent note;
+        int offset;                 // frame within the current block
+    };
+
+    struct LatencySample {
+        int string;
+        double latency;             // seconds from input to the note's first sample
+    };
+
+    constexpr int MAX_PENDING_NOTES = 64;
+
+    AudioStream stream = { 0 };
+    double scheduleLatency = 0.0;   // one frame plus one block
+
+    SpscQueue<NoteEvent, 256> noteQueue;
+    SpscQueue<LatencySample, 256> latencyQueue;
+    std::atomic<bool> measureLatency(false);
+
+    // Audio thread state, sized in InitAudioEngine before the stream starts
+    StringBank strings;
+    NoteEvent pending[MAX_PENDING_NOTES];
+    int pendingCount = 0;
+    ScheduledNote due[MAX_PENDING_NOTES];
+    uint32_t noiseSeed = 22222;
+
+    double AudioClock() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Every note is played a fixed latency after its input: it is queued at most one frame after time, so it is
+    // due at (time + scheduleLatency), which is at least one block ahead of the callback that picks it up. Notes
+    // due after this block wait in pending. Only a frame that ran late gets a note due in the past, which then
+    // plays at the start of the block. Returns the notes due in this block, sorted.
+    int ScheduleNotes(const double blockStart, const unsigned int frames) {
+        NoteEvent note;
+        while (pendingCount < MAX_PENDING_NOTES && noteQueue.pop(note)) {
+            pending[pendingCount++] = note;
+        }
+
+        int kept = 0;
+        int dueCount = 0;
+        for (int i = 0; i < pendingCount; ++i) {
+            const double dueTime = pending[i].time + scheduleLatency - blockStart;
+            const int offset = std::max(0, static_cast<int>(dueTime * AUDIO_SAMPLE_RATE));
+            if (offset >= static_cast<int>(frames)) {
+                pending[kept++] = pending[i];
+                continue;
+            }
+            due[dueCount++] = {pending[i], offset};
+            if (measureLatency.load(std::memory_order_relaxed)) {
+                latencyQueue.push({pending[i].string, blockStart - pending[i].time + static_cast<double>(offset) / AUDIO_SAMPLE_RATE});
+            }
+        }
+        pendingCount = kept;
+
+        std::sort(due, due + dueCount, [](const ScheduledNote& a, const ScheduledNote& b) { return a.offset < b.offset; });
+        return dueCount;
+    }
+
+    void RenderAudio(void* bufferData, const unsigned int frames) {
+        float* out = static_cast<float*>(bufferData);
+        std::fill(out, out + frames, 0.0f);
+
+        // Render up to each note's offset, then excite its string, so every pluck starts on its exact sample
+        const int dueCount = ScheduleNotes(AudioClock(), frames);
+        int rendered = 0;
+        for (int i = 0; i < dueCount; ++i) {
+            const NoteEvent& note = due[i].note;
+            if (note.string < 0 || note.string >= strings.count) continue;
+            RenderStringBank(strings, out + rendered, due[i].offset - rendered);
+            rendered = due[i].offset;
+            ExciteString(strings, note.string, AUDIO_SAMPLE_RATE, note.frequency, note.velocity, note.position, noiseSeed);
+        }
+        RenderStringBank(strings, out + rendered, frames - rendered);
+
+        for (unsigned int i = 0; i < frames; ++i) {
+            out[i] *= MASTER_GAIN;
+        }
+    }
+}
+
+bool InitAudioEngine(const AudioSettings& settings, const int stringCount) {
+    if (stringCount <= 0) return false;
+    InitStringBank(strings, stringCount);
+
+    measureLatency.store(settings.measureLatency);
+    scheduleLatency = settings.frameSeconds + static_cast<double>(settings.bufferFrames) / AUDIO_SAMPLE_RATE;
+
+    SetAudioStreamBufferSizeDefault(settings.bufferFrames);
+    stream = LoadAudioStream(AUDIO_SAMPLE_RATE, 32, 1);
+    SetAudioStreamCallback(stream, RenderAudio);
+    PlayAudioStream(stream);
+    return true;
+}
+
+void ShutdownAudioEngine() {
+    StopAudioStream(stream);
+    UnloadAudioStream(stream);
+    stream = AudioStream{ 0 };
+    InitStringBank(strings, 0);
+}
+
+double GetAudioClock() {
+    return AudioClock();
+}
+
+void QueueNoteOn(const int string, const float frequency, const float velocity, const float position, const double time) {
+    noteQueue.push({string, frequency, velocity, position, time});
+}
+
+void SetLatencyMeasurement(const bool enabled) {
+    measureLatency.store(enabled);
+}
+
+bool IsLatencyMeasurementEnabled() {
+    return measureLatency.load();
+}
+
+void LogAudioLatency() {
+    LatencySample sample;
+    while (latencyQueue.pop(sample)) {
+        TraceLog(LOG_INFO, "AUDIO: string %d input-to-first-sample %.2f ms", sample.string, sample.latency * 1000.0);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef AUDIO_ENGINE_H
+#define AUDIO_ENGINE_H
+
+#include "raylib.h"
+
+constexpr int AUDIO_SAMPLE_RATE = 48000;
+
+struct AudioSettings {
+    int bufferFrames = 256;         // audio stream buffer size, part of the fixed scheduling latency
+    double frameSeconds = 1.0 / 60; // input is read once per frame, so a note can be this old when it is queued
+    bool measureLatency = false;    // log input-to-first-sample time of every note
+};
+
+// Plucked-string synthesis driven by the audio callback instead of the render loop. Every string has its own
+// Karplus-Strong delay line. The game thread queues note-on events stamped with the time of the input that caused
+// them; the audio thread excites the string at the sample matching that time plus one frame and one buffer, a fixed
+// latency, so notes keep their spacing from the input and do not inherit the 16 ms jitter of the frame loop.
+bool InitAudioEngine(const AudioSettings& settings, int stringCount);
+void ShutdownAudioEngine();
+
+// Seconds on the clock notes are scheduled against, steady and shared by both threads
+double GetAudioClock();
+
+// Called from the game thread. velocity is 0..1, position is where along the string (0..1) it was plucked, time is
+// when it was plucked on the GetAudioClock() timeline.
+void QueueNoteOn(int string, float frequency, float velocity, float position, double time);
+
+void SetLatencyMeasurement(bool enabled);
+bool IsLatencyMeasurementEnabled();
+// Drains latency samples reported by the audio thread and logs them. Called once per frame.
+void LogAudioLatency();
+
+#endif //AUDIO_ENGINE_H
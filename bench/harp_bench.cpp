@@ -0,0 +1,62 @@
+// Per-frame cost of the headless harp update (interaction for every chord plus rebuilding the meshes of the chords
+// that moved), driven by a scripted glissando at 10k simulated frames per second. With fingers, that many injected
+// touches sweep the strings at once instead of the mouse, each out of phase with the others.
+// Usage: HarpBench [strings] [fingers], e.g. HarpBench 47 10 for ten fingers on a concert pedal harp layout.
+#include "../harp.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+constexpr int SIM_FPS = 10000;
+constexpr int SIM_SECONDS = 10;
+constexpr float SWEEP_SPEED = 1500.0f;      // pointer speed in px/s, fast enough to pluck on every crossing
+
+// Pointer sweeping up and down across every string, in the middle of the harp where strings can be grabbed.
+Vector2 ScriptedPointer(const long frame) {
+    const float top = 100.0f;
+    const float bottom = screenHeight - 100.0f;
+    const float span = bottom - top;
+    const float travelled = std::fmod(frame * SWEEP_SPEED / SIM_FPS, span * 2.0f);
+    const float y = travelled < span ? top + travelled : bottom - (travelled - span);
+    return {screenWidth / 2.0f, y};
+}
+
+int main(int argc, char** argv) {
+    const int strings = argc > 1 ? std::max(2, atoi(argv[1])) : CHORDS;
+    const int fingers = argc > 2 ? std::min(std::max(0, atoi(argv[2])), MAX_TOUCH_POINTS) : 0;
+    Harp harp;
+    addChords(harp, strings);
+
+    const int frames = SIM_FPS * SIM_SECONDS;
+    std::vector<double> costs(frames);
+    long plucks = 0;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        HarpInput input = {ScriptedPointer(frame), 1.0f / SIM_FPS};
+        input.touchCount = fingers;
+        for (int f = 0; f < fingers; ++f) {
+            const Vector2 sweep = ScriptedPointer(frame + static_cast<long>(f) * SIM_FPS / 7);
+            input.touches[f] = {f, {sweep.x + (f - fingers / 2) * 20.0f, sweep.y}};
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        UpdateHarp(harp, input);
+        UpdateChordMeshes(harp);
+        costs[frame] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        plucks += harp.plucks.size();
+    }
+
+    double total = 0.0;
+    for (const double cost : costs) total += cost;
+    std::sort(costs.begin(), costs.end());
+
+    std::cout << "strings: " << strings << ", fingers: " << fingers << ", frames: " << frames << ", plucks: " << plucks << std::endl;
+    std::cout << "update ns/frame mean: " << total / frames
+              << ", p50: " << costs[frames / 2]
+              << ", p99: " << costs[frames * 99 / 100]
+              << ", max: " << costs.back() << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Frame cost of the string update and tessellation split across 1, 2 and 8 job system threads, on a 47-string harp
+// swept by a scripted glissando at 60 FPS. The whole simulation state is hashed after the run; it has to come out
+// the same for every thread count, and the exit status is non-zero if it does not.
+#include "../harp.h"
+#include "../job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+constexpr int STRINGS = 47;
+constexpr int FRAMES = 6000;
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+Vector2 ScriptedPointer(const int frame) {
+    // Up and down across all strings twice a second, drifting sideways to pluck at different positions
+    const float phase = fmodf(frame * FRAME_TIME * 2.0f, 2.0f);
+    const float y = 100.0f + (screenHeight - 200.0f) * (phase < 1.0f ? phase : 2.0f - phase);
+    return {screenWidth / 2.0f + 60.0f * sinf(frame * FRAME_TIME), y};
+}
+
+// FNV-1a over raw bytes, so any difference down to the last float bit shows
+void HashBytes(uint64_t& hash, const void* data, const size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+}
+
+template <typename T>
+void HashVector(uint64_t& hash, const std::vector<T>& values) {
+    if (!values.empty()) HashBytes(hash, values.data(), values.size() * sizeof(T));
+}
+
+uint64_t HashHarp(const Harp& harp, const long plucks) {
+    uint64_t hash = 14695981039346656037ull;
+    HashVector(hash, harp.chords.displacement);
+    for (const ChordMesh& mesh : harp.chords.meshes) {
+        HashVector(hash, mesh.strips.stringStrip);
+        HashVector(hash, mesh.strips.shadowStrip);
+    }
+    HashVector(hash, harp.strings.amplitude);
+    HashVector(hash, harp.strings.velocity);
+    HashVector(hash, harp.strings.current);
+    HashBytes(hash, &plucks, sizeof(plucks));
+    return hash;
+}
+
+uint64_t Run(const int threads) {
+    JobSystem jobs(threads);
+    Harp* harp = new Harp();
+    addChords(*harp, STRINGS);
+
+    std::vector<double> costs(FRAMES);
+    long plucks = 0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        UpdateHarp(*harp, {ScriptedPointer(frame), FRAME_TIME}, &jobs);
+        UpdateChordMeshes(*harp, &jobs);
+        costs[frame] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        plucks += harp->plucks.size();
+    }
+    const uint64_t hash = HashHarp(*harp, plucks);
+    delete harp;
+
+    double total = 0.0;
+    for (const double cost : costs) total += cost;
+    std::sort(costs.begin(), costs.end());
+    std::cout << threads << " thread(s): " << total / FRAMES << " us/frame mean, p99 " << costs[FRAMES * 99 / 100]
+              << " us, plucks " << plucks << ", state hash " << std::hex << hash << std::dec << std::endl;
+    return hash;
+}
+
+int main() {
+    const int threadCounts[] = {1, 2, 8};
+    uint64_t reference = 0;
+    bool deterministic = true;
+    for (const int threads : threadCounts) {
+        const uint64_t hash = Run(threads);
+        if (threads == threadCounts[0]) reference = hash;
+        deterministic = deterministic && hash == reference;
+    }
+    std::cout << (deterministic ? "deterministic across thread counts" : "STATE DIFFERS between thread counts") << std::endl;
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// MIDI pluck bus over a loopback port: a scripted 60 FPS glissando on one harp is published as MIDI and received by
+// a second harp, which must replay every pluck on the same string, at the same time and with the same velocity (to
+// MIDI resolution).
+// Reports the per-frame cost of publishing plus receiving, counts heap allocations on that path, and checks the
+// file stand-in port gives back what was written.
+#include "../harp.h"
+#include "../midi.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+constexpr int FRAMES = 6000;
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+constexpr float SWEEP_SPEED = 3000.0f;
+
+Vector2 ScriptedPointer(const int frame) {
+    const float top = 100.0f;
+    const float span = screenHeight - 200.0f;
+    const float travelled = std::fmod(frame * FRAME_TIME * SWEEP_SPEED, span * 2.0f);
+    return {screenWidth / 2.0f, travelled < span ? top + travelled : top + span * 2.0f - travelled};
+}
+
+int main() {
+    Harp player;
+    Harp listener;
+    addChords(player, CHORDS);
+    addChords(listener, CHORDS);
+    player.plucks.reserve(64);
+    listener.plucks.reserve(64);
+
+    MidiLoopbackPort loopback;
+    MidiBus out;
+    MidiBus in;
+    out.port = &loopback;
+    in.port = &loopback;
+
+    long sent = 0;
+    long mismatches = 0;
+    long busAllocations = 0;
+    std::vector<double> costs;
+    costs.reserve(FRAMES);
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        UpdateHarp(player, {ScriptedPointer(frame), FRAME_TIME});
+        UpdateHarp(listener, {{0, 0}, FRAME_TIME});      // pointer parked off the strings
+
+        const long before = allocations;
+        const auto start = std::chrono::steady_clock::now();
+        PublishPlucks(out, player.plucks, player.time);
+        ReceiveMidi(in, listener, listener.time);
+        costs.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        busAllocations += allocations - before;
+
+        sent += player.plucks.size();
+        if (player.plucks.size() != listener.plucks.size()) {
+            ++mismatches;
+            continue;
+        }
+        for (size_t i = 0; i < player.plucks.size(); ++i) {
+            const PluckEvent& a = player.plucks[i];
+            const PluckEvent& b = listener.plucks[i];
+            if (a.string != b.string || fabs(a.time - b.time) > 1e-9 ||
+                fabsf(a.velocity - b.velocity) > 0.5f / 127.0f + 1e-6f || b.source != PLUCK_EXTERNAL) {
+                ++mismatches;
+            }
+        }
+    }
+
+    // File stand-in: write a few messages, read them back
+    const char* path = "midi_bench.mid.raw";
+    {
+        MidiFilePort file(path, nullptr);
+        for (int note = 0; note < 16; ++note) {
+            file.send({note * 0.5, static_cast<unsigned char>(MIDI_NOTE_ON), static_cast<unsigned char>(48 + note), 100});
+        }
+    }
+    int readBack = 0;
+    {
+        MidiFilePort file(nullptr, path);
+        MidiMessage message;
+        while (file.receive(message)) {
+            readBack += message.data1 == 48 + readBack && message.time == readBack * 0.5;
+        }
+    }
+    std::remove(path);
+
+    std::sort(costs.begin(), costs.end());
+    std::cout << "frames: " << FRAMES << ", plucks sent: " << sent << ", mismatched frames: " << mismatches
+              << ", allocations on the bus: " << busAllocations << ", file records read back: " << readBack << "/16"
+              << std::endl;
+    std::cout << "publish + receive ns/frame p50: " << costs[FRAMES / 2] << ", p99: " << costs[FRAMES * 99 / 100]
+              << ", max: " << costs.back() << std::endl;
+    return mismatches == 0 && busAllocations == 0 && readBack == 16 ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+// Cost of rendering the Karplus-Strong string bank, in nanoseconds per output sample per sounding voice, for each
+// kernel the CPU supports. Used to pick a safe polyphony cap for a given machine.
+#include "../karplus_strong.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int BUFFER_FRAMES = 256;
+constexpr int SECONDS = 2;
+
+volatile float sink;
+
+double nsPerSamplePerVoice(const int voices) {
+    StringBank bank;
+    InitStringBank(bank, voices);
+    uint32_t seed = 1;
+
+    std::vector<float> buffer(BUFFER_FRAMES);
+    const int buffers = SAMPLE_RATE * SECONDS / BUFFER_FRAMES;
+    double elapsed = 0.0;
+    for (int b = 0; b < buffers; ++b) {
+        // Keep every voice sounding: re-pluck each string twice a second, staggered
+        for (int v = b % (buffers / (SECONDS * 2)); v < voices; v += buffers / (SECONDS * 2)) {
+            ExciteString(bank, v, SAMPLE_RATE, ScaleFrequency(v % 35, 65.41f), 1.0f, 0.5f, seed);
+        }
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+
+        const auto start = std::chrono::steady_clock::now();
+        RenderStringBank(bank, buffer.data(), BUFFER_FRAMES);
+        elapsed += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        sink = buffer[0];
+    }
+    return elapsed / (static_cast<double>(buffers) * BUFFER_FRAMES * voices);
+}
+
+int main() {
+    const int voiceCounts[] = {8, 64, 256};
+    const StringBankKernel kernels[] = {KS_KERNEL_GENERIC, KS_KERNEL_AVX2};
+    const StringBankKernel detected = GetStringBankKernel();
+
+    std::cout << "kernel,voices,ns_per_sample_per_voice" << std::endl;
+    for (const StringBankKernel kernel : kernels) {
+        if (!SetStringBankKernel(kernel)) {
+            std::cout << StringBankKernelName(kernel) << ",unsupported," << std::endl;
+            continue;
+        }
+        for (const int voices : voiceCounts) {
+            std::cout << StringBankKernelName(kernel) << "," << voices << "," << nsPerSamplePerVoice(voices) << std::endl;
+        }
+    }
+    std::cout << "runtime dispatch picks: " << StringBankKernelName(detected) << std::endl;
+    return 0;
+}
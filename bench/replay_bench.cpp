@@ -0,0 +1,102 @@
+// Headless replay of an input recording (DigiHarp --record) as fast as possible: per-frame cost of the harp update
+// and tessellation, and the pluck event log. The recording is replayed twice and the two logs must match, so a
+// change that makes the interaction depend on anything but the recorded input fails here.
+// Usage: ReplayBench [recording] [event log], without a recording a scripted 60 FPS glissando is recorded first.
+#include "../harp.h"
+#include "../input_recording.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+constexpr int SCRIPT_FPS = 60;
+constexpr int SCRIPT_SECONDS = 30;
+constexpr float SWEEP_SPEED = 3000.0f;      // px/s, a fast glissando that crosses several strings per frame
+
+std::vector<HarpInput> ScriptedRecording() {
+    std::vector<HarpInput> frames;
+    const float top = 100.0f;
+    const float span = screenHeight - 200.0f;
+    for (int frame = 0; frame < SCRIPT_FPS * SCRIPT_SECONDS; ++frame) {
+        const float travelled = std::fmod(frame * SWEEP_SPEED / SCRIPT_FPS, span * 2.0f);
+        const float y = travelled < span ? top + travelled : top + span * 2.0f - travelled;
+        frames.push_back({{screenWidth / 2.0f, y}, 1.0f / SCRIPT_FPS});
+    }
+    return frames;
+}
+
+// Replays every frame, logging plucks to log; returns the update cost of each frame in ns
+std::vector<double> Replay(const std::vector<HarpInput>& frames, std::FILE* log, long& plucks) {
+    Harp harp;
+    addChords(harp, CHORDS);
+    std::vector<double> costs(frames.size());
+    plucks = 0;
+    for (size_t frame = 0; frame < frames.size(); ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        UpdateHarp(harp, frames[frame]);
+        UpdateChordMeshes(harp);
+        costs[frame] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        plucks += harp.plucks.size();
+        WritePluckLog(log, frame, harp.plucks);
+    }
+    return costs;
+}
+
+std::string ReadAll(std::FILE* file) {
+    std::string text;
+    std::rewind(file);
+    char buffer[4096];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, read);
+    return text;
+}
+
+int main(int argc, char** argv) {
+    std::vector<HarpInput> frames;
+    if (argc > 1) {
+        if (!LoadInputRecording(argv[1], frames)) {
+            std::cerr << "could not load recording " << argv[1] << std::endl;
+            return 1;
+        }
+    } else {
+        // Round trip through the file format, so the script exercises the same path as a real recording
+        const char* path = "replay_bench_script.dhir";
+        if (!SaveInputRecording(path, ScriptedRecording()) || !LoadInputRecording(path, frames)) {
+            std::cerr << "could not write scripted recording " << path << std::endl;
+            return 1;
+        }
+        std::remove(path);
+    }
+
+    std::FILE* first = argc > 2 ? std::fopen(argv[2], "w+") : std::tmpfile();
+    std::FILE* second = std::tmpfile();
+    if (first == nullptr || second == nullptr) {
+        std::cerr << "could not open event logs" << std::endl;
+        return 1;
+    }
+    long plucks = 0;
+    std::vector<double> costs = Replay(frames, first, plucks);
+    long replayedPlucks = 0;
+    Replay(frames, second, replayedPlucks);
+    const bool deterministic = ReadAll(first) == ReadAll(second);
+    std::fclose(first);
+    std::fclose(second);
+
+    double total = 0.0;
+    for (const double cost : costs) total += cost;
+    std::sort(costs.begin(), costs.end());
+    const size_t count = costs.size();
+
+    std::cout << "frames: " << count << ", plucks: " << plucks << std::endl;
+    if (count > 0) {
+        std::cout << "update ns/frame mean: " << total / count
+                  << ", p50: " << costs[count / 2]
+                  << ", p99: " << costs[count * 99 / 100]
+                  << ", max: " << costs.back() << std::endl;
+    }
+    std::cout << (deterministic ? "event logs match" : "EVENT LOGS DIFFER between replays") << std::endl;
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+// Per-frame cost of the string drop-shadow offsets: evaluating ParabolaSecondPhase for every sample (old drawChords)
+// against indexing the per-chord table built by BuildShadowProfile.
+#include "../shadow_profile.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+constexpr float MAX_CORD_SIZE = 6.0f;
+constexpr float MIN_CORD_SIZE = 2.0f;
+constexpr float SHADOW_HEIGHT = 10.0f;
+constexpr int STRING_TEXTURES = 80;
+constexpr int FRAMES = 2000;
+
+volatile float sink;
+
+int textureSegmentsFor(const int index, const int strings) {
+    const float sizeRate = (MAX_CORD_SIZE - MIN_CORD_SIZE) / (strings - 1);
+    const float cordSize = MAX_CORD_SIZE - (index * sizeRate);
+    return (STRING_TEXTURES / 2)/3 * cordSize;
+}
+
+double nsPerFrame(const std::chrono::steady_clock::time_point start) {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / FRAMES;
+}
+
+int main() {
+    const int stringCounts[] = {10, 50, 200};
+    std::cout << "strings,old_ns_per_frame,table_ns_per_frame" << std::endl;
+
+    for (const int strings : stringCounts) {
+        std::vector<int> segments(strings);
+        std::vector<std::vector<float>> profiles(strings);
+        for (int i = 0; i < strings; ++i) {
+            segments[i] = textureSegmentsFor(i, strings);
+            BuildShadowProfile(profiles[i], segments[i], SHADOW_HEIGHT);
+        }
+
+        float acc = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            for (int i = 0; i < strings; ++i) {
+                const int textureSegments = segments[i];
+                for (int seg = 0; seg < 2; ++seg) {
+                    for (int j = 0; j < textureSegments; ++j) {
+                        const float x = seg == 0 ? textureSegments - j : j;
+                        acc += ParabolaSecondPhase(x, textureSegments, SHADOW_HEIGHT);
+                    }
+                }
+            }
+        }
+        const double oldCost = nsPerFrame(start);
+        sink = acc;
+
+        acc = 0.0f;
+        start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            for (int i = 0; i < strings; ++i) {
+                const std::vector<float>& profile = profiles[i];
+                for (size_t k = 0; k < profile.size(); ++k) {
+                    acc += profile[k];
+                }
+            }
+        }
+        const double tableCost = nsPerFrame(start);
+        sink = acc;
+
+        std::cout << strings << "," << oldCost << "," << tableCost << std::endl;
+    }
+    return 0;
+}
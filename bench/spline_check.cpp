@@ -0,0 +1,94 @@
+// Checks the power-form Catmull-Rom segments in spline.h against raylib on every chord of the harp, at rest and
+// pulled up to PLUCK_THRESHOLD at several points along its length: sample positions must match
+// GetSplinePointCatmullRom to 1e-3 px, and the analytic tangent must match the finite-difference angle the strings
+// were drawn with before (two spline points 0.01 apart in t) to 0.3 degrees. That angle is the secant's, so it is
+// compared with the tangent halfway along it; at t itself the two differ by the secant's own error, several degrees
+// where a string is pulled hard close to a bolt. Where the curve doubles back on itself the secant is a fraction of a
+// pixel long and neither angle means anything, so those samples only count for position. Exits non-zero on any miss.
+#include "../harp.h"
+#include "../spline.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+constexpr float MAX_POSITION_ERROR = 1e-3f;    // px; float rounding at ~1000 px is ~1e-4, a visible error ~0.1
+constexpr float MAX_ANGLE_ERROR = 0.3f;        // degrees
+constexpr int SAMPLES_PER_SEGMENT = 64;
+
+constexpr float ANGLE_DT = 0.01f;
+constexpr float MIN_SECANT = 0.1f;             // px
+
+// What drawChords used for the sample rotation before the analytic tangents. Returns false if the secant is too short
+// to have a direction.
+bool FiniteDifferenceAngle(const Vector2 p1, const Vector2 p2, const Vector2 p3, const Vector2 p4, const float t,
+                           float& angle) {
+    const Vector2 a = GetSplinePointCatmullRom(p1, p2, p3, p4, t);
+    const Vector2 b = GetSplinePointCatmullRom(p1, p2, p3, p4, t + ANGLE_DT);
+    angle = atan2f(b.y - a.y, b.x - a.x) * RAD2DEG;
+    return hypotf(b.x - a.x, b.y - a.y) >= MIN_SECANT;
+}
+
+int main() {
+    Harp harp;
+    addChords(harp, CHORDS);
+    ChordBank& chords = harp.chords;
+
+    const float pulls[] = {0.0f, -1.0f, -0.5f, 0.25f, 1.0f};
+    const float alongs[] = {0.1f, 0.3f, 0.5f, 0.8f};
+
+    long samples = 0;
+    long misses = 0;
+    long skippedAngles = 0;
+    float worstPosition = 0.0f;
+    float worstAngle = 0.0f;
+    for (int chord = 0; chord < chords.count; ++chord) {
+        const Vector2 rest = chords.rest[chord];
+        const float length = chords.right[chord] - chords.left[chord];
+        for (const float pull : pulls) {
+            for (const float along : alongs) {
+                chords.displacement[chord] = {chords.left[chord] + along * length - rest.x, pull * PLUCK_THRESHOLD};
+                const std::array<Vector2, 5> points = ChordControlPoints(chords, chord);
+
+                for (int seg = 0; seg < 5 - 3; ++seg) {
+                    const Vector2 p1 = points[seg], p2 = points[seg + 1], p3 = points[seg + 2], p4 = points[seg + 3];
+                    const CatmullRomSegment spline = MakeCatmullRomSegment(p1, p2, p3, p4);
+                    for (int j = 0; j < SAMPLES_PER_SEGMENT; ++j) {
+                        const float t = (float)j / (SAMPLES_PER_SEGMENT - 1);
+                        Vector2 point, tangent, ignored;
+                        CatmullRomPointTangent(spline, t, point, tangent);
+                        CatmullRomPointTangent(spline, t + ANGLE_DT / 2, ignored, tangent);
+
+                        const Vector2 expected = GetSplinePointCatmullRom(p1, p2, p3, p4, t);
+                        const float positionError = std::max(fabsf(point.x - expected.x), fabsf(point.y - expected.y));
+                        float oldAngle;
+                        float angleError = 0.0f;
+                        if (FiniteDifferenceAngle(p1, p2, p3, p4, t, oldAngle)) {
+                            angleError = fabsf(atan2f(tangent.y, tangent.x) * RAD2DEG - oldAngle);
+                            angleError = std::min(angleError, 360.0f - angleError);
+                        } else {
+                            ++skippedAngles;
+                        }
+
+                        worstPosition = std::max(worstPosition, positionError);
+                        worstAngle = std::max(worstAngle, angleError);
+                        if (positionError > MAX_POSITION_ERROR || angleError > MAX_ANGLE_ERROR) {
+                            if (misses < 10) {
+                                std::cout << "chord " << chord << " pull " << pull << " at " << along << " segment "
+                                          << seg << " t " << t << ": position off by " << positionError
+                                          << " px, angle off by " << angleError << " deg" << std::endl;
+                            }
+                            ++misses;
+                        }
+                        ++samples;
+                    }
+                }
+            }
+        }
+        chords.displacement[chord] = {0, 0};
+    }
+
+    std::cout << "samples: " << samples << " (" << skippedAngles << " without a direction), misses: " << misses
+              << ", worst position error: " << worstPosition
+              << " px, worst angle error: " << worstAngle << " deg" << std::endl;
+    return misses == 0 ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+// Soak test for the UI texture cache: opens a hidden window and, for N frames, draws the UI background gradient and
+// the blurred rounded-rectangle shadows through the same cache calls as DrawUIBackground and
+// DrawRoundedRectangleWithShadow. The cache must hold one texture per distinct set of parameters and resident memory
+// must not grow once the first frames have filled it. Exits non-zero on either.
+// Usage: TextureCacheSoak [frames]
+#include "../texture_cache.h"
+#include <cstdio>
+#include <iostream>
+#include <stdlib.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+constexpr int SCREEN_WIDTH = 1400;
+constexpr int SCREEN_HEIGHT = 850;
+constexpr int WARMUP_FRAMES = 60;
+constexpr long MAX_RSS_GROWTH_KB = 4096;       // allocator and driver noise; one leaked gradient alone is ~1.7 MB
+
+// Resident set size in KB, or -1 where it is not available (only read on Linux, from /proc)
+long ResidentKb() {
+#ifdef __linux__
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) return -1;
+    long pages = 0;
+    long resident = 0;
+    const bool ok = std::fscanf(statm, "%ld %ld", &pages, &resident) == 2;
+    std::fclose(statm);
+    return ok ? resident * (sysconf(_SC_PAGESIZE) / 1024) : -1;
+#else
+    return -1;
+#endif
+}
+
+// One frame of both UI paths, with the parameters main.cpp uses
+void DrawCachedUI(TextureCache& cache, const int frame) {
+    const float color1 = 0.18f;
+    const float color2 = 0.20f;
+    const Texture2D background = GetCachedGradient(cache, SCREEN_WIDTH/2 - 300, SCREEN_HEIGHT, 0,
+                                                   ColorFromNormalized({color1, color1, color1, 1.0f}),
+                                                   ColorFromNormalized({color2, color2, color2, 1.0f}));
+    DrawTexture(background, 0, 0, WHITE);
+
+    // Two panels with different shadows, the second one moving: position is not part of the key
+    const Rectangle panels[2] = {{40, 40, 300, 180}, {400.0f + frame % 200, 300, 220, 120}};
+    const int sizes[2] = {20, 12};
+    for (int i = 0; i < 2; ++i) {
+        const Rectangle rect = panels[i];
+        const Texture2D shadow = GetCachedBlurredRect(cache, rect.width, rect.height, sizes[i], 0.5f);
+        DrawTexturePro(shadow, {0, 0, (float)shadow.width, (float)shadow.height}, rect, {0, 0}, 0.0f, WHITE);
+    }
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : 3000;
+    const size_t expectedTextures = 3;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "TextureCacheSoak");
+
+    TextureCache cache;
+    long baseline = -1;
+    size_t largestCache = 0;
+    for (int frame = 0; frame < WARMUP_FRAMES + frames; ++frame) {
+        if (frame == WARMUP_FRAMES) baseline = ResidentKb();
+        BeginDrawing();
+        ClearBackground(BLACK);
+        DrawCachedUI(cache, frame);
+        EndDrawing();
+        if (cache.textures.size() > largestCache) largestCache = cache.textures.size();
+    }
+    const long after = ResidentKb();
+
+    UnloadTextureCache(cache);
+    CloseWindow();
+
+    const long growth = baseline >= 0 && after >= 0 ? after - baseline : 0;
+    std::cout << "frames: " << frames << ", cached textures: " << largestCache << " (expected " << expectedTextures
+              << "), resident memory: " << baseline << " KB -> " << after << " KB" << std::endl;
+    return largestCache == expectedTextures && growth <= MAX_RSS_GROWTH_KB ? 0 : 1;
+}
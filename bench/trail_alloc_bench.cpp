@@ -0,0 +1,99 @@
+// Heap allocations per frame of the cursor trail: the old std::queue trail (one push per pixel, pops of 40, a copy
+// of the whole queue to draw it) against the PointerTrail ring buffer, over the same scripted 60 FPS pointer path.
+#include "../harp.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <queue>
+
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+constexpr int FRAMES = 6000;
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+// Pointer circling over the strings, about 1500 px/s
+Vector2 ScriptedPointer(const int frame) {
+    const float angle = frame * FRAME_TIME * 3.0f;
+    return {screenWidth / 2.0f + 250.0f * cosf(angle), screenHeight / 2.0f + 250.0f * sinf(angle)};
+}
+
+// The trail as it was before the ring buffer: push every interpolated pixel, pop 40 at a time, copy to draw.
+float QueueTrailFrame(std::queue<Vector2>& cursorQueue, const Vector2 pointer) {
+    if (cursorQueue.size() > 2) {
+        const Vector2 prev = cursorQueue.back();
+        const int steps = (int)V2Distance(prev, pointer);
+        for (int j = 0; j <= steps; j++) {
+            const float t = steps > 0 ? (float)j / steps : 1.0f;
+            cursorQueue.push({Lerp(prev.x, pointer.x, t), Lerp(prev.y, pointer.y, t)});
+        }
+    }
+    cursorQueue.push(pointer);
+    if (cursorQueue.size() > 40) {
+        for (int i = 0; i < 40; ++i) {
+            cursorQueue.pop();
+        }
+    }
+
+    float drawn = 0.0f;
+    std::queue<Vector2> copyQueue(cursorQueue);
+    while (!copyQueue.empty()) {
+        drawn += copyQueue.front().x;
+        copyQueue.pop();
+    }
+    return drawn;
+}
+
+float RingTrailFrame(Harp& harp, const Vector2 pointer) {
+    UpdateHarp(harp, {pointer, FRAME_TIME});
+
+    float drawn = 0.0f;
+    const int count = harp.cursorTrail.size();
+    for (int i = 0; i < count; ++i) {
+        drawn += harp.cursorTrail[i].position.x;
+    }
+    return drawn;
+}
+
+int main() {
+    float sink = 0.0f;
+
+    std::queue<Vector2> cursorQueue;
+    allocations = 0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        sink += QueueTrailFrame(cursorQueue, ScriptedPointer(frame));
+    }
+    const long queueAllocations = allocations;
+
+    Harp harp;
+    addChords(harp, CHORDS);
+    harp.plectrum = MakePlectrum(PLECTRUM_TRAIL);
+    // Let the pluck and held-chord vectors reach their working capacity first
+    for (int frame = 0; frame < 60; ++frame) {
+        sink += RingTrailFrame(harp, ScriptedPointer(frame));
+    }
+    allocations = 0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        sink += RingTrailFrame(harp, ScriptedPointer(frame));
+    }
+    const long ringAllocations = allocations;
+
+    std::cout << "frames: " << FRAMES << " (checksum " << sink << ")" << std::endl;
+    std::cout << "std::queue trail allocations/frame: " << (double)queueAllocations / FRAMES << std::endl;
+    std::cout << "ring buffer trail allocations/frame: " << (double)ringAllocations / FRAMES << std::endl;
+    return 0;
+}
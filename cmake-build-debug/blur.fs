@@ -0,0 +1,23 @@
+#version 330
+
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 direction;     // one texel along the blur axis, in uv units
+uniform float radius;       // blur radius in texels
+
+void main() {
+    float sigma = max(radius * 0.5, 0.001);
+    int taps = int(radius);
+
+    vec4 sum = vec4(0.0);
+    float weightSum = 0.0;
+    for (int i = -taps; i <= taps; ++i) {
+        float weight = exp(-float(i * i) / (2.0 * sigma * sigma));
+        sum += texture(texture0, fragTexCoord + direction * float(i)) * weight;
+        weightSum += weight;
+    }
+
+    finalColor = sum / weightSum;
+}
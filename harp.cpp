@@ -0,0 +1,549 @@
+#include "harp.h"
+#include "job_system.h"
+#include "shadow_profile.h"
+#include "spline.h"
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <stdlib.h>
+
+int chordTextureSegments(const float cordSize) {
+    const int numSegments = 5 - 3;      // Catmull-Rom requires at least 4 points per segment
+    return (STRING_TEXTURES / numSegments)/3 * cordSize;
+}
+
+void updateShadowProfile(ChordMesh& mesh, const float thickness, const float length) {
+    BuildShadowProfile(mesh.shadowProfile, chordTextureSegments(thickness), SHADOW_HEIGHT);
+    mesh.profileThickness = thickness;
+    mesh.profileLength = length;
+}
+
+std::array<Vector2, 5> ChordControlPoints(const ChordBank& chords, const int chord) {
+    const Vector2 rest = chords.rest[chord];
+    const Vector2 middle = {rest.x + chords.displacement[chord].x, rest.y + chords.displacement[chord].y};
+    const Vector2 left = {chords.left[chord], rest.y};
+    const Vector2 right = {chords.right[chord], rest.y};
+    return {left, left, middle, right, right};
+}
+
+// Where along its length (0..1) the chord's middle control point is
+float ChordPosition(const ChordBank& chords, const int chord) {
+    const float x = chords.rest[chord].x + chords.displacement[chord].x;
+    return (x - chords.left[chord]) / (chords.right[chord] - chords.left[chord]);
+}
+
+// Reports when, how hard and where along its length the chord was plucked; the front-end turns that into sound.
+void pluckString(Harp& harp, const int index, const float velocity, const double time) {
+    harp.plucks.push_back({index, velocity, ChordPosition(harp.chords, index), time});
+}
+
+Plectrum MakePlectrum(const PlectrumShape shape) {
+    Plectrum plectrum;
+    plectrum.shape = shape;
+    if (shape == PLECTRUM_BOW) {
+        plectrum.size = bow;
+    }
+    return plectrum;
+}
+
+// Part of a chord the plectrum can take hold of: its rest line, minus a sixth of the length at each end.
+struct ChordReach {
+    float restY;
+    float left;
+    float right;
+};
+
+ChordReach GetChordReach(const ChordBank& chords, const int chord) {
+    const float cordLen = chords.right[chord] - chords.left[chord];
+    const int sideThreshold = cordLen/6;
+    return {chords.rest[chord].y, chords.left[chord] + sideThreshold, chords.right[chord] - sideThreshold};
+}
+
+// Chords per job when work is split across threads: a few strings' solver state or spline tessellations
+constexpr int CHORDS_PER_JOB = 4;
+
+void ForChordChunks(JobSystem* jobs, const int count, const std::function<void(int, int)>& body) {
+    if (jobs) {
+        jobs->parallelFor(count, CHORDS_PER_JOB, body);
+    } else {
+        body(0, count);
+    }
+}
+
+// Visual vibration frequency of the thickest string, Hz
+constexpr float VISUAL_FUNDAMENTAL = 6.0f;
+
+// Band around the rest line within which a point or trail sample takes hold of the string
+constexpr float GRAB_DISTANCE = 10.0f;
+// Plectrum speed, in px/s, at which a string swept in passing is plucked at full velocity
+constexpr float GLISSANDO_FULL_SPEED = 4000.0f;
+
+// Whether the plectrum touches the chord while moving from -> to. at is how far along the segment (0..1) it first
+// did, which for a point is where the segment crossed the rest line when it jumped over it.
+bool SweepTouches(const Plectrum& plectrum, const Vector2 from, const Vector2 to, const ChordReach& reach, float& at) {
+    if (plectrum.shape == PLECTRUM_BOW) {
+        if (to.x < reach.left || to.x + plectrum.size.x > reach.right) return false;
+        if (reach.restY >= from.y && reach.restY <= from.y + plectrum.size.y) {
+            at = 0.0f;
+            return true;
+        }
+        // The rectangle entered the rest line with its bottom edge moving down or its top edge moving up
+        const float top = reach.restY > from.y ? reach.restY - plectrum.size.y : reach.restY;
+        if ((top - from.y) * (top - to.y) > 0.0f) return false;
+        at = (top - from.y) / (to.y - from.y);
+        return true;
+    }
+
+    if (fabsf(to.y - reach.restY) <= GRAB_DISTANCE && to.x >= reach.left && to.x <= reach.right) {
+        at = 1.0f;
+        return true;
+    }
+    if ((from.y - reach.restY) * (to.y - reach.restY) >= 0.0f) return false;
+    at = (reach.restY - from.y) / (to.y - from.y);
+    const float x = Lerp(from.x, to.x, at);
+    return x >= reach.left && x <= reach.right;
+}
+
+// A stretch of plectrum path and the simulation times at its two ends.
+struct PlectrumSegment {
+    Vector2 from;
+    Vector2 to;
+    double fromTime;
+    double toTime;
+};
+
+// Hands a chord the plectrum let go of back to the string solver, starting from the shape it was pulled into.
+void ReleaseChord(Harp& harp, const int index) {
+    ReleaseString(harp.strings, index, ChordPosition(harp.chords, index), harp.chords.displacement[index].y);
+}
+
+// Drags a held chord along the plectrum segment. It follows while it stays within PLUCK_THRESHOLD of the rest line,
+// is plucked at the point and time where the segment leaves that band, and is dropped if the plectrum slides off its
+// end. A chord that was pulled over earlier samples is plucked as hard as it was pulled; one the segment caught and
+// flung in a single stretch (a glissando) is plucked as hard as the plectrum was moving. Returns whether the chord
+// is still held.
+bool DragChord(Harp& harp, const int index, const ChordReach& reach, const PlectrumSegment& segment, const bool caught) {
+    ChordBank& chords = harp.chords;
+    chords.atRest[index] = false;
+    chords.dirty[index] = true;
+
+    const Vector2 rest = chords.rest[index];
+    const Vector2 grabPoint = chords.grabPoint[index];
+    const Vector2 start = {segment.from.x + grabPoint.x, segment.from.y + grabPoint.y};
+    const Vector2 held = {segment.to.x + grabPoint.x, segment.to.y + grabPoint.y};
+    if (fabsf(held.y - reach.restY) <= PLUCK_THRESHOLD) {
+        if (held.x >= reach.left && held.x <= reach.right) {
+            chords.displacement[index] = {held.x - rest.x, held.y - rest.y};
+            return true;
+        }
+        chords.grab[index] = false;
+        ReleaseChord(harp, index);
+        return false;
+    }
+
+    double time = segment.fromTime;
+    if (fabsf(start.y - reach.restY) <= PLUCK_THRESHOLD) {
+        const float edge = reach.restY + (held.y > reach.restY ? PLUCK_THRESHOLD : -PLUCK_THRESHOLD);
+        const float t = (edge - start.y) / (held.y - start.y);
+        const Vector2 exit = {Lerp(start.x, held.x, t), edge};
+        if (exit.x >= reach.left && exit.x <= reach.right) {
+            chords.displacement[index] = {exit.x - rest.x, exit.y - rest.y};
+        }
+        time = segment.fromTime + t * (segment.toTime - segment.fromTime);
+    }
+
+    float velocity;
+    if (caught && segment.toTime > segment.fromTime) {
+        const float speed = fabsf(held.y - start.y) / (segment.toTime - segment.fromTime);
+        velocity = std::min(speed / GLISSANDO_FULL_SPEED, 1.0f);
+    } else {
+        velocity = std::min(fabsf(chords.displacement[index].y) / PLUCK_THRESHOLD, 1.0f);
+    }
+    pluckString(harp, index, velocity, time);
+    chords.grab[index] = false;
+    ReleaseChord(harp, index);
+    return false;
+}
+
+void BuildChordIndex(Harp& harp) {
+    harp.chordsByRestY.resize(harp.chords.count);
+    for (int i = 0; i < harp.chords.count; ++i) {
+        harp.chordsByRestY[i] = i;
+    }
+    const std::vector<Vector2>& rest = harp.chords.rest;
+    std::sort(harp.chordsByRestY.begin(), harp.chordsByRestY.end(), [&rest](const int a, const int b) {
+        return rest[a].y < rest[b].y;
+    });
+}
+
+void PluckChord(Harp& harp, const int index, const float velocity, const double time, const PluckSource source) {
+    ChordBank& chords = harp.chords;
+    if (index < 0 || index >= chords.count || chords.grab[index]) return;
+
+    const float pulled = std::min(std::max(velocity, 0.0f), 1.0f);
+    chords.displacement[index] = {0, pulled * PLUCK_THRESHOLD};
+    chords.atRest[index] = false;
+    chords.dirty[index] = true;
+    ReleaseChord(harp, index);
+    harp.plucks.push_back({index, pulled, ChordPosition(chords, index), time, source});
+}
+
+void SweepPlectrum(Harp& harp, Plectrum& plectrum, const PointerSample& sample) {
+    // Only the bow latches: it hooks a string on entry and has to leave it before it can hook it again
+    const bool latches = plectrum.shape == PLECTRUM_BOW;
+    ChordBank& chords = harp.chords;
+    const auto restYBelow = [&chords](const int chord, const float y) { return chords.rest[chord].y < y; };
+
+    const Vector2 to = sample.position;
+    const double toTime = sample.time;
+    const PlectrumSegment segment = {
+        plectrum.tracking ? plectrum.lastSample : to, to,
+        plectrum.tracking ? plectrum.lastTime : toTime, toTime
+    };
+    const Vector2 from = segment.from;
+    plectrum.lastSample = to;
+    plectrum.lastTime = toTime;
+    plectrum.tracking = true;
+
+    // New grabs go first so a chord let go further down cannot be caught again by the same segment
+    const int alreadyHeld = plectrum.heldChords.size();
+
+    // Rest lines the segment can reach: the grab band around a point, the whole rectangle of a bow
+    const float low = std::min(from.y, to.y) - (latches ? 0.0f : GRAB_DISTANCE);
+    const float high = std::max(from.y, to.y) + (latches ? plectrum.size.y : GRAB_DISTANCE);
+    auto candidate = std::lower_bound(harp.chordsByRestY.begin(), harp.chordsByRestY.end(), low, restYBelow);
+    for (; candidate != harp.chordsByRestY.end() && chords.rest[*candidate].y <= high; ++candidate) {
+        const int i = *candidate;
+        if (chords.grab[i] || !chords.canBeGrabbed[i]) continue;
+
+        const ChordReach reach = GetChordReach(chords, i);
+        float at;
+        if (!SweepTouches(plectrum, from, to, reach, at)) continue;
+
+        // The rest of the segment, from the moment of contact
+        const PlectrumSegment afterContact = {
+            {Lerp(from.x, to.x, at), Lerp(from.y, to.y, at)}, to,
+            segment.fromTime + at * (segment.toTime - segment.fromTime), segment.toTime
+        };
+        chords.grab[i] = true;
+        HoldString(harp.strings, i);
+        chords.grabPoint[i] = latches ? Vector2{plectrum.size.x/2, reach.restY - afterContact.from.y} : Vector2{0, 0};
+        if (latches) {
+            chords.canBeGrabbed[i] = false;
+            plectrum.latchedChords.push_back(i);
+        }
+        if (DragChord(harp, i, reach, afterContact, true)) {
+            plectrum.heldChords.push_back(i);
+        }
+    }
+
+    for (int h = 0, remaining = alreadyHeld; remaining > 0; --remaining) {
+        const int i = plectrum.heldChords[h];
+        if (DragChord(harp, i, GetChordReach(chords, i), segment, false)) {
+            ++h;
+        } else {
+            plectrum.heldChords.erase(plectrum.heldChords.begin() + h);
+        }
+    }
+
+    // Unlatching last, so a string the bow is leaving is not hooked again by its trailing edge
+    for (size_t l = 0; l < plectrum.latchedChords.size();) {
+        const int i = plectrum.latchedChords[l];
+        float at;
+        if (SweepTouches(plectrum, to, to, GetChordReach(chords, i), at)) {
+            ++l;
+        } else {
+            chords.canBeGrabbed[i] = true;
+            plectrum.latchedChords.erase(plectrum.latchedChords.begin() + l);
+        }
+    }
+}
+
+void InteractChords(Harp& harp, Plectrum& plectrum, const PointerTrail& samples, const int first) {
+    const int count = samples.size();
+    for (int s = first; s < count; ++s) {
+        SweepPlectrum(harp, plectrum, samples[s]);
+    }
+}
+
+void LiftPlectrum(Harp& harp, Plectrum& plectrum) {
+    ChordBank& chords = harp.chords;
+    for (const int i : plectrum.heldChords) {
+        pluckString(harp, i, std::min(fabsf(chords.displacement[i].y) / PLUCK_THRESHOLD, 1.0f), harp.time);
+        chords.grab[i] = false;
+        ReleaseChord(harp, i);
+    }
+    for (const int i : plectrum.latchedChords) {
+        chords.canBeGrabbed[i] = true;
+    }
+    plectrum.heldChords.clear();
+    plectrum.latchedChords.clear();
+    plectrum.tracking = false;
+}
+
+void HandleTouches(Harp& harp, const HarpInput& input) {
+    const int touchCount = std::min(std::max(input.touchCount, 0), MAX_TOUCH_POINTS);
+    const auto touchOf = [&input, touchCount](const int id) {
+        for (int t = 0; t < touchCount; ++t) {
+            if (input.touches[t].id == id) return t;
+        }
+        return -1;
+    };
+
+    for (Finger& finger : harp.fingers) {
+        if (finger.id >= 0 && touchOf(finger.id) < 0) {
+            LiftPlectrum(harp, finger.plectrum);
+            finger.id = -1;
+        }
+    }
+    for (int t = 0; t < touchCount; ++t) {
+        const int id = input.touches[t].id;
+        bool known = false;
+        for (const Finger& finger : harp.fingers) known |= finger.id == id;
+        for (int f = 0; !known && f < MAX_TOUCH_POINTS; ++f) {
+            if (harp.fingers[f].id >= 0) continue;
+            harp.fingers[f].id = id;
+            harp.fingers[f].plectrum.tracking = false;
+            known = true;
+        }
+    }
+
+    for (Finger& finger : harp.fingers) {
+        if (finger.id < 0) continue;
+        SweepPlectrum(harp, finger.plectrum, {input.touches[touchOf(finger.id)].position, harp.time});
+    }
+}
+
+void StepHarpPhysics(Harp& harp, JobSystem* jobs) {
+    const double step = 1.0 / PHYSICS_RATE;
+    int steps = 0;
+    while (harp.physicsTime + step <= harp.time) {
+        harp.physicsTime += step;
+        ++steps;
+    }
+    const float alpha = (harp.time - harp.physicsTime) / step;
+
+    // Strings are independent, so each chunk runs all of this frame's steps for its own strings in one go
+    ForChordChunks(jobs, harp.chords.count, [&harp, steps, alpha](const int begin, const int end) {
+        StringModes& strings = harp.strings;
+        ChordBank& chords = harp.chords;
+        for (int k = 0; k < steps; ++k) {
+            StepStringModes(strings, begin, end);
+        }
+
+        for (int i = begin; i < end; ++i) {
+            if (chords.grab[i] || chords.atRest[i]) continue;
+
+            if (!strings.moving[i]) {
+                chords.displacement[i] = {0, 0};
+                chords.atRest[i] = true;
+            } else {
+                const float x = Lerp(chords.left[i], chords.right[i], strings.position[i]);
+                chords.displacement[i] = {x - chords.rest[i].x, Lerp(strings.previous[i], strings.current[i], alpha)};
+            }
+            chords.dirty[i] = true;
+        }
+    });
+}
+
+void AddChord(ChordBank& chords, const float left, const float right, const Vector2 rest, const float thickness) {
+    chords.left.push_back(left);
+    chords.right.push_back(right);
+    chords.rest.push_back(rest);
+    chords.displacement.push_back({0, 0});
+    chords.thickness.push_back(thickness);
+    chords.grabPoint.push_back({0, 0});
+    chords.grab.push_back(false);
+    chords.canBeGrabbed.push_back(true);
+    chords.atRest.push_back(false);
+    chords.dirty.push_back(true);
+    chords.meshes.emplace_back();
+    updateShadowProfile(chords.meshes.back(), thickness, right - left);
+    ++chords.count;
+}
+
+void addChords(Harp& harp, const int amount) {
+    const float verticalMargin = 130.0f;
+    const float height_rate = ((screenHeight - verticalMargin) - verticalMargin) / (amount - 1);
+    const float sizeRate = (MAX_CORD_SIZE - MIN_CORD_SIZE) / (amount - 1);
+    for (int i = 0; i < amount; ++i) {
+        const auto height = static_cast<float>(verticalMargin + (height_rate * i));
+        const float length_rate = (MAX_CORD_LENGTH - MIN_CORD_LENGTH) / (amount - 1);
+        const float length = 1.0f * MAX_CORD_LENGTH - (length_rate * (i));
+
+        const float finalStartX = (screenWidth - length)/2;
+        const float finalEndX = screenWidth - finalStartX;
+        AddChord(harp.chords, finalStartX, finalEndX, {screenWidth/2, height}, MAX_CORD_SIZE - (i * sizeRate));
+    }
+    BuildChordIndex(harp);
+
+    // Thinner strings swing faster
+    std::vector<float> fundamentals(harp.chords.count);
+    for (int i = 0; i < harp.chords.count; ++i) {
+        fundamentals[i] = VISUAL_FUNDAMENTAL * sqrtf(MAX_CORD_SIZE / harp.chords.thickness[i]);
+    }
+    InitStringModes(harp.strings, fundamentals);
+}
+
+// Evaluates the spline of a chord at every texture sample. Only called for chords that moved; at-rest chords keep
+// reusing the cached samples. Segment coefficients are built once per call, then each sample is a Horner evaluation
+// of the position and the analytic tangent.
+void SampleChordSpline(std::vector<SplineSample>& samples, const std::array<Vector2, 5>& points, const int textureSegments) {
+    const int numSegments = 5 - 3;      // Catmull-Rom requires at least 4 points per segment
+    samples.resize(numSegments * textureSegments);
+
+    for (int seg = 0; seg < numSegments; ++seg) {
+        const CatmullRomSegment spline = MakeCatmullRomSegment(points[seg], points[seg + 1],
+                                                               points[seg + 2], points[seg + 3]);
+
+        for (int j = 0; j < textureSegments; ++j) {
+            const float t = (float)j / (textureSegments - 1); // Normalize t per segment
+            SplineSample& sample = samples[seg * textureSegments + j];
+            CatmullRomPointTangent(spline, t, sample.position, sample.tangent);
+        }
+    }
+}
+
+void BuildStringMesh(StringMesh& mesh, const std::vector<SplineSample>& samples, const std::vector<float>& shadowProfile, const float cordSize) {
+    const int totalSamples = samples.size();
+    const float stringHalf = cordSize / 2;
+    const float shadowHalf = cordSize * 3;
+
+    mesh.stringStrip.resize(totalSamples * 2);
+    mesh.shadowStrip.resize(totalSamples * 2);
+    mesh.texCoords.resize(totalSamples);
+
+    for (int k = 0; k < totalSamples; ++k) {
+        const Vector2 point = samples[k].position;
+        const Vector2 normal = {-samples[k].tangent.y, samples[k].tangent.x};
+        const float shadowOffset = shadowProfile[k];
+
+        mesh.stringStrip[k*2] = {point.x - normal.x * stringHalf, point.y - normal.y * stringHalf};
+        mesh.stringStrip[k*2 + 1] = {point.x + normal.x * stringHalf, point.y + normal.y * stringHalf};
+        mesh.shadowStrip[k*2] = {point.x - normal.x * shadowHalf, point.y - normal.y * shadowHalf + shadowOffset};
+        mesh.shadowStrip[k*2 + 1] = {point.x + normal.x * shadowHalf, point.y + normal.y * shadowHalf + shadowOffset};
+        mesh.texCoords[k] = (float)k;
+    }
+
+    mesh.builtSize = cordSize;
+}
+
+void HandleCursor(Harp& harp, const HarpInput& input) {
+    const float mx = input.pointer.x;
+    const float my = input.pointer.y;
+    const Vector2 back = harp.cursorTrail.back().position;
+    const float max = std::max(abs(mx-back.x), abs(my-back.y));
+    if (abs(mx-back.x) > abs(my-back.y)) {
+        for (int i = back.x; i < mx; mx < back.x ? --i : ++i) {
+            harp.cursorTrail.push({{static_cast<float>(i), static_cast<float>(std::min(back.y + (i - back.x), my))}, harp.time});
+        }
+    } else if (abs(mx-back.x) < abs(my-back.y)) {
+        for (int i = back.y; i < my; my < back.y ? --i : ++i) {
+            harp.cursorTrail.push({{static_cast<float>(std::min(back.x + (i - back.y), mx)), static_cast<float>(i)}, harp.time});
+        }
+    } else {
+        for (int i = back.x; i < max; ++i) {
+            harp.cursorTrail.push({{static_cast<float>(i), static_cast<float>(i)}, harp.time});
+        }
+    }
+
+    if (!harp.cursorTrail.empty()) {
+        const Vector2 front = harp.cursorTrail.front().position;
+        if (harp.cursorPosition.x > front.x) {
+            harp.cursorPosition.x--;
+        } else {
+            harp.cursorPosition.x++;
+        }
+
+        if (harp.cursorPosition.y > front.y) {
+            harp.cursorPosition.y--;
+        } else {
+            harp.cursorPosition.y++;
+        }
+        if (abs(harp.cursorPosition.x - front.x) <= 6.0f && abs(harp.cursorPosition.y - front.y) <= 6.0f) {
+            harp.cursorTrail.pop_front();
+        }
+    }
+
+}
+
+float V2Distance(Vector2 one, Vector2 two) {
+    return sqrtf(powf(one.x - two.x, 2) + powf(one.y - two.y, 2));
+}
+
+float Lerp(float a, float b, float t) {
+    return a + t * (b - a);
+}
+
+// Drops the samples older than TRAIL_MAX_AGE and returns how many of the newest added samples survived.
+int TrimCursorTrail(Harp& harp, const int added) {
+    while (!harp.cursorTrail.empty() && harp.cursorTrail.front().time < harp.time - TRAIL_MAX_AGE) {
+        harp.cursorTrail.pop_front();
+    }
+    return std::min(added, (int)harp.cursorTrail.size());
+}
+
+int RecordPointer(Harp& harp, const HarpInput& input) {
+    harp.cursorTrail.push({input.pointer, harp.time});
+    return TrimCursorTrail(harp, 1);
+}
+
+int HandleTrailCursor(Harp& harp, const HarpInput& input) {
+    if (input.pointer.x == 0 && input.pointer.y == 0) return 0;
+    int added = 0;
+    if (harp.cursorTrail.size() > 2) {
+        const PointerSample prev = harp.cursorTrail.back();
+        float distance = V2Distance(prev.position, {(float)input.pointer.x, (float)input.pointer.y});
+        int steps = (int)distance; // One circle per pixel distance
+
+        for (int j = 0; j <= steps; j++) {
+            const float t = steps > 0 ? (float)j / steps : 1.0f; // Interpolation factor
+            Vector2 interpolated = {
+                Lerp(prev.position.x, input.pointer.x, t),
+                Lerp(prev.position.y, input.pointer.y, t)
+            };
+            harp.cursorTrail.push({interpolated, prev.time + t * (harp.time - prev.time)});
+            ++added;
+        }
+    }
+    harp.cursorTrail.push({{(float)input.pointer.x, (float)input.pointer.y}, harp.time});
+    return TrimCursorTrail(harp, added + 1);
+}
+
+void updateChordMesh(ChordBank& chords, const int chord) {
+    ChordMesh& mesh = chords.meshes[chord];
+    const float thickness = chords.thickness[chord];
+    const float length = chords.right[chord] - chords.left[chord];
+    if (mesh.profileThickness != thickness || mesh.profileLength != length) {
+        updateShadowProfile(mesh, thickness, length);
+        chords.dirty[chord] = true;
+    }
+    if (chords.dirty[chord] || mesh.strips.builtSize != thickness) {
+        SampleChordSpline(mesh.samples, ChordControlPoints(chords, chord), chordTextureSegments(thickness));
+        BuildStringMesh(mesh.strips, mesh.samples, mesh.shadowProfile, thickness);
+        chords.dirty[chord] = false;
+    }
+}
+
+void UpdateChordMeshes(Harp& harp, JobSystem* jobs) {
+    ForChordChunks(jobs, harp.chords.count, [&harp](const int begin, const int end) {
+        for (int i = begin; i < end; ++i) {
+            updateChordMesh(harp.chords, i);
+        }
+    });
+}
+
+void UpdateHarp(Harp& harp, const HarpInput& input, JobSystem* jobs) {
+    harp.plucks.clear();
+    harp.time += input.frameTime;
+    HandleTouches(harp, input);
+    if (input.touchCount > 0) {
+        // The mouse follows the first finger on most touchscreens; it starts afresh once every finger is up
+        LiftPlectrum(harp, harp.plectrum);
+    } else {
+        const int added = harp.plectrum.shape == PLECTRUM_TRAIL ? HandleTrailCursor(harp, input) : RecordPointer(harp, input);
+        // Only the samples added this step, older ones have already been through the strings
+        InteractChords(harp, harp.plectrum, harp.cursorTrail, harp.cursorTrail.size() - added);
+    }
+    StepHarpPhysics(harp, jobs);
+}
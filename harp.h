@@ -0,0 +1,206 @@
+#ifndef HARP_H
+#define HARP_H
+
+// Headless harp simulation: string layout, grab/pluck interaction and the string meshes. Input and time come in
+// through HarpInput and plucks come out as PluckEvents, so nothing here touches the window, the mouse or the
+// audio device. raylib.h is only included for Vector2.
+#include "raylib.h"
+#include "ring_buffer.h"
+#include "string_physics.h"
+#include <array>
+#include <vector>
+
+class JobSystem;
+
+constexpr int screenWidth = 1400;
+constexpr int screenHeight = 850;
+constexpr float MAX_CORD_SIZE = 6.0f;
+constexpr float MIN_CORD_SIZE = 2.0f;
+constexpr float MAX_CORD_LENGTH = 320.0f;
+constexpr float MIN_CORD_LENGTH = 320.0f;
+constexpr int CHORDS = 10;
+constexpr float SHADOW_HEIGHT = 10.0f;
+constexpr int PLUCK_THRESHOLD = 30;
+constexpr int STRING_TEXTURES = 80;
+constexpr Vector2 bow = {25, 300};
+constexpr int POINTER_TRAIL_CAPACITY = 4096;        // power of two; a full screen swipe per frame at one sample per px
+constexpr int MAX_TOUCH_POINTS = 10;          // fingers tracked at once, each with its own plectrum
+constexpr float TRAIL_MAX_AGE = 0.15f;              // seconds a pointer sample stays on the trail
+
+// Tessellated string body and drop shadow for one chord, two vertices (top/bottom edge) per spline sample.
+// Kept between frames and only rebuilt when the chord's middle control point moves.
+struct StringMesh {
+    std::vector<Vector2> stringStrip;
+    std::vector<Vector2> shadowStrip;
+    std::vector<float> texCoords;               // u coordinate per sample, one whole texture per sample quad
+    float builtSize = 0.0f;
+};
+
+struct SplineSample {
+    Vector2 position;
+    Vector2 tangent;                            // unit direction of the string at this sample
+};
+
+// Tessellation cache of one chord: spline samples, shadow profile and the strips built from them. Only touched when
+// the chord moved, so it is kept apart from the per-frame state.
+struct ChordMesh {
+    StringMesh strips;
+    std::vector<SplineSample> samples;          // cached spline evaluation, valid while the chord is not dirty
+    std::vector<float> shadowProfile;           // shadow offset per sample, see BuildShadowProfile
+    float profileThickness = 0.0f;              // thickness/length the shadow profile was built for
+    float profileLength = 0.0f;
+};
+
+// The strings, structure-of-arrays: every array has one entry per chord, in string order. A chord is the Catmull-Rom
+// spline through its two bolts (each doubled as an end point) and one middle control point, rest + displacement.
+// Hit testing, holding and posing each read only the few arrays they need. The shadow is not stored separately; it
+// is built from the same spline samples as the string.
+struct ChordBank {
+    int count = 0;
+    std::vector<float> left;                    // x of the two bolts, on the rest line
+    std::vector<float> right;
+    std::vector<Vector2> rest;                  // middle control point of the still string
+    std::vector<Vector2> displacement;          // middle control point now, relative to rest
+    std::vector<float> thickness;
+    std::vector<Vector2> grabPoint;             // string relative to the plectrum while held
+    std::vector<unsigned char> grab;
+    std::vector<unsigned char> canBeGrabbed;
+    std::vector<unsigned char> atRest;          // vibration died out, string back on its rest line
+    std::vector<unsigned char> dirty;           // moved since its mesh was built
+    std::vector<ChordMesh> meshes;
+};
+
+// Spline control points of a chord: left bolt twice, the middle point, right bolt twice.
+std::array<Vector2, 5> ChordControlPoints(const ChordBank& chords, int chord);
+
+enum PluckSource {
+    PLUCK_PLECTRUM,                             // the player's pointer
+    PLUCK_EXTERNAL                              // PluckChord, e.g. an incoming MIDI note
+};
+
+struct PluckEvent {
+    int string = 0;
+    float velocity = 0.0f;                      // 0..1, how far the string was pulled
+    float position = 0.0f;                      // 0..1, where along the string it was pulled
+    double time = 0.0;                          // Harp::time at which it was plucked, interpolated within the step
+    PluckSource source = PLUCK_PLECTRUM;
+
+    PluckEvent() {}
+    PluckEvent(int string_, float velocity_, float position_, double time_, PluckSource source_ = PLUCK_PLECTRUM)
+        : string(string_), velocity(velocity_), position(position_), time(time_), source(source_) {}
+};
+
+struct TouchPoint {
+    int id;                                     // stays the same from touch down to lift
+    Vector2 position;
+};
+
+// Everything the simulation reads from the outside world for one update.
+struct HarpInput {
+    Vector2 pointer = {0, 0};                   // mouse position
+    float frameTime = 0.0f;                     // seconds since the previous update
+    int touchCount = 0;                         // fingers down; while there are any the mouse pointer is ignored
+    std::array<TouchPoint, MAX_TOUCH_POINTS> touches = {};
+
+    HarpInput() {}
+    HarpInput(Vector2 pointer_, float frameTime_) : pointer(pointer_), frameTime(frameTime_) {}
+};
+
+struct PointerSample {
+    Vector2 position;
+    double time;                                // Harp::time it was recorded at
+};
+
+typedef RingBuffer<PointerSample, POINTER_TRAIL_CAPACITY> PointerTrail;
+
+enum PlectrumShape {
+    PLECTRUM_POINT,                             // the pointer itself
+    PLECTRUM_TRAIL,                             // every sample of the interpolated cursor trail
+    PLECTRUM_BOW                                // a size-sized rectangle hanging from the pointer
+};
+
+// What the strings are plucked with. A point or trail grabs a string whenever its path comes within reach of the
+// rest line or crosses it; the bow hooks a string once as the rest line enters the rectangle and holds it by the grab
+// offset.
+struct Plectrum {
+    PlectrumShape shape = PLECTRUM_POINT;
+    Vector2 size = {0, 0};
+    Vector2 lastSample = {0, 0};                // where the previous sample left it, start of the next swept segment
+    double lastTime = 0.0;                      // Harp::time of lastSample
+    bool tracking = false;                      // lastSample is valid
+    std::vector<int> heldChords;                // strings it holds, these follow every sample wherever it goes
+    std::vector<int> latchedChords;             // strings the bow hooked and has not cleared yet
+};
+
+Plectrum MakePlectrum(PlectrumShape shape);
+
+// A finger on the touchscreen, plucking with its own point plectrum. A string is held by at most one plectrum at a
+// time, so one finger can press a string while the others pluck elsewhere.
+struct Finger {
+    int id = -1;                                // touch id, -1 while the slot is free
+    Plectrum plectrum;
+};
+
+struct Harp {
+    ChordBank chords;
+    Plectrum plectrum;                          // the mouse pointer's
+    std::array<Finger, MAX_TOUCH_POINTS> fingers;
+    std::vector<int> chordsByRestY;             // chord indices sorted by rest line, see BuildChordIndex
+    Vector2 cursorPosition = {0, 0};
+    PointerTrail cursorTrail;                   // recent pointer samples, oldest first, at most TRAIL_MAX_AGE old
+    std::vector<PluckEvent> plucks;             // emitted by the last UpdateHarp
+    double time = 0.0;                          // simulation time in seconds, the sum of all frame times
+    StringModes strings;                        // vibration of the chords, same order
+    double physicsTime = 0.0;                   // time the string solver has been stepped up to
+};
+
+void addChords(Harp& harp, int amount);
+
+// Sorts the chords by rest line so the interaction only has to look at the strings near each plectrum segment.
+// addChords calls it; call it again after moving rest lines by hand.
+void BuildChordIndex(Harp& harp);
+
+// Runs the grab/hold/pluck state machine over the plectrum path through samples[first..], oldest first. Grabbed
+// strings leave the solver, released ones go back into it with the shape they were pulled into.
+// Each segment between consecutive samples is swept against the strings, so a string between two far apart samples
+// is still caught, and its pluck is timed where the segment crossed it. Only held chords and the chords whose rest
+// line lies in the segment's y range are visited: O(log n) to find them in chordsByRestY instead of a test per string.
+void InteractChords(Harp& harp, Plectrum& plectrum, const PointerTrail& samples, int first);
+// One segment of that: from where the plectrum was last seen to sample.
+void SweepPlectrum(Harp& harp, Plectrum& plectrum, const PointerSample& sample);
+// The plectrum leaves the harp: strings it holds are plucked as hard as they were pulled and it stops tracking, so
+// its next sample starts a new path instead of sweeping from the old one.
+void LiftPlectrum(Harp& harp, Plectrum& plectrum);
+// Gives every new touch a free finger, lifts the fingers whose touch is gone and sweeps the rest to their new
+// positions, in finger order so the result does not depend on the order touches are reported in.
+void HandleTouches(Harp& harp, const HarpInput& input);
+
+// Steps the string solver in fixed 1/PHYSICS_RATE steps up to harp.time and poses every chord that is not held,
+// interpolating between the last two steps so motion stays smooth at any frame rate. With a job system the strings
+// are split into chunks across its threads; the result is the same for any thread count.
+void StepHarpPhysics(Harp& harp, JobSystem* jobs = nullptr);
+void HandleCursor(Harp& harp, const HarpInput& input);
+// Both append this step's pointer samples to cursorTrail, drop the ones past TRAIL_MAX_AGE and return how many they
+// appended. RecordPointer adds the pointer itself; HandleTrailCursor fills the way up to it, one sample per pixel.
+int RecordPointer(Harp& harp, const HarpInput& input);
+int HandleTrailCursor(Harp& harp, const HarpInput& input);
+
+// Plucks a string from outside the plectrum: releases it from its middle, pulled velocity (0..1) of the way to
+// PLUCK_THRESHOLD, and reports it in harp.plucks with the given source. time is when it was played on the Harp::time
+// clock, no later than harp.time, so it sounds then rather than when the frame got to it. A string held by the
+// plectrum is left alone. Call after UpdateHarp, which clears harp.plucks.
+void PluckChord(Harp& harp, int index, float velocity, double time, PluckSource source);
+
+// One simulation step: feeds the touches through their fingers' plectra, or the pointer (or the cursor trail)
+// through the harp's plectrum when no finger is down, collects the plucks they produced and moves the strings on.
+void UpdateHarp(Harp& harp, const HarpInput& input, JobSystem* jobs = nullptr);
+
+// Rebuilds the chord's cached spline samples and string mesh if it moved since the last call.
+void updateChordMesh(ChordBank& chords, int chord);
+// updateChordMesh for every chord, in chunks across the job system's threads when there is one.
+void UpdateChordMeshes(Harp& harp, JobSystem* jobs = nullptr);
+
+float V2Distance(Vector2 one, Vector2 two);
+float Lerp(float a, float b, float t);
+
+#endif //HARP_H
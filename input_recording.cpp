@@ -0,0 +1,79 @@
+#include "input_recording.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    const char RECORDING_MAGIC[4] = {'D', 'H', 'I', 'R'};
+    constexpr uint32_t RECORDING_VERSION = 2;
+    constexpr uint32_t RECORDING_VERSION_NO_TOUCH = 1;
+    constexpr int FLOATS_PER_FRAME = 3;
+
+    struct TouchRecord {
+        int32_t id;
+        float x;
+        float y;
+    };
+}
+
+bool SaveInputRecording(const char* path, const std::vector<HarpInput>& frames) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    const uint32_t header[2] = {RECORDING_VERSION, static_cast<uint32_t>(frames.size())};
+    bool ok = std::fwrite(RECORDING_MAGIC, sizeof(RECORDING_MAGIC), 1, file) == 1
+           && std::fwrite(header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; ok && i < frames.size(); ++i) {
+        const HarpInput& frame = frames[i];
+        const float values[FLOATS_PER_FRAME] = {frame.pointer.x, frame.pointer.y, frame.frameTime};
+        const uint32_t touchCount = std::min(std::max(frame.touchCount, 0), MAX_TOUCH_POINTS);
+        ok = std::fwrite(values, sizeof(values), 1, file) == 1 && std::fwrite(&touchCount, sizeof(touchCount), 1, file) == 1;
+        for (uint32_t t = 0; ok && t < touchCount; ++t) {
+            const TouchRecord touch = {frame.touches[t].id, frame.touches[t].position.x, frame.touches[t].position.y};
+            ok = std::fwrite(&touch, sizeof(touch), 1, file) == 1;
+        }
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+bool LoadInputRecording(const char* path, std::vector<HarpInput>& frames) {
+    frames.clear();
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    char magic[4];
+    uint32_t header[2];
+    bool ok = std::fread(magic, sizeof(magic), 1, file) == 1
+           && std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) == 0
+           && std::fread(header, sizeof(header), 1, file) == 1
+           && (header[0] == RECORDING_VERSION || header[0] == RECORDING_VERSION_NO_TOUCH);
+    if (ok) {
+        const bool hasTouches = header[0] != RECORDING_VERSION_NO_TOUCH;
+        frames.resize(header[1]);
+        for (HarpInput& frame : frames) {
+            float values[FLOATS_PER_FRAME];
+            uint32_t touchCount = 0;
+            ok = std::fread(values, sizeof(values), 1, file) == 1
+              && (!hasTouches || std::fread(&touchCount, sizeof(touchCount), 1, file) == 1)
+              && touchCount <= MAX_TOUCH_POINTS;
+            frame = {{values[0], values[1]}, values[2]};
+            frame.touchCount = touchCount;
+            for (uint32_t t = 0; ok && t < touchCount; ++t) {
+                TouchRecord touch;
+                ok = std::fread(&touch, sizeof(touch), 1, file) == 1;
+                frame.touches[t] = {touch.id, {touch.x, touch.y}};
+            }
+            if (!ok) break;
+        }
+    }
+    std::fclose(file);
+    if (!ok) frames.clear();
+    return ok;
+}
+
+void WritePluckLog(std::FILE* log, const long frame, const std::vector<PluckEvent>& plucks) {
+    for (const PluckEvent& pluck : plucks) {
+        std::fprintf(log, "%ld string=%d velocity=%.4f position=%.4f time=%.6f\n",
+                     frame, pluck.string, pluck.velocity, pluck.position, pluck.time);
+    }
+}
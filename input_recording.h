@@ -0,0 +1,22 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+// Recorded input for deterministic replays. UpdateHarp only depends on the HarpInput of every frame, so feeding a
+// recorded sequence back reproduces the same plucks and string motion, live or headless, at any replay speed.
+#include "harp.h"
+#include <cstdio>
+#include <vector>
+
+// File layout, little-endian: "DHIR", uint32 version, uint32 frame count, then per frame three float32 (pointer x,
+// pointer y, frame time) and a uint32 touch count followed by an int32 id and two float32 (x, y) per touch. 16 bytes
+// per mouse-only frame, about 58 KB for a minute at 60 FPS. Version 1 files, without the touches, still load.
+bool SaveInputRecording(const char* path, const std::vector<HarpInput>& frames);
+// Replaces frames with the recording at path. Returns false, leaving frames empty, if the file is missing, truncated
+// or not a recording.
+bool LoadInputRecording(const char* path, std::vector<HarpInput>& frames);
+
+// Appends one line per pluck of the given frame: frame, string, velocity, position and time, at a fixed precision,
+// so the logs of two replays of the same recording can be diffed.
+void WritePluckLog(std::FILE* log, long frame, const std::vector<PluckEvent>& plucks);
+
+#endif //INPUT_RECORDING_H
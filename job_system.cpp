@@ -0,0 +1,94 @@
+#include "job_system.h"
+#include <algorithm>
+
+JobSystem::JobSystem(const int threads)
+    : threadCount_(std::max(1, threads)), queues_(new WorkQueue[std::max(1, threads)]) {
+    for (int i = 1; i < threadCount_; ++i) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepLock_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void JobSystem::parallelFor(const int count, const int chunkSize, const std::function<void(int, int)>& body) {
+    if (count <= 0) return;
+    const int chunk = std::max(1, chunkSize);
+    if (threadCount_ == 1 || count <= chunk) {
+        body(0, count);
+        return;
+    }
+
+    const int chunks = (count + chunk - 1) / chunk;
+    std::atomic<int> remaining(chunks);
+    for (int c = 0; c < chunks; ++c) {
+        WorkQueue& queue = queues_[c % threadCount_];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.jobs.push_back({&body, c * chunk, std::min(count, (c + 1) * chunk), &remaining});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepLock_);
+        queued_ += chunks;
+    }
+    wake_.notify_all();
+
+    // The caller works too instead of blocking, and leaves only once the last chunk, possibly stolen, is done
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (takeJob(0, job)) {
+            runJob(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::takeJob(const int self, Job& job) {
+    {
+        WorkQueue& own = queues_[self];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+    for (int k = 1; k < threadCount_; ++k) {
+        WorkQueue& victim = queues_[(self + k) % threadCount_];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::runJob(const Job& job) {
+    (*job.body)(job.begin, job.end);
+    job.remaining->fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(const int self) {
+    for (;;) {
+        Job job;
+        if (takeJob(self, job)) {
+            runJob(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepLock_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_) return;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads for splitting per-string work across cores. Every thread, the caller included, has
+// its own deque: it works through its own chunks newest first and, when that runs dry, steals the oldest chunk from
+// another thread. parallelFor returns once every chunk has run, so the caller can use the results straight away.
+// A pool of one thread runs everything inline on the caller.
+class JobSystem {
+public:
+    explicit JobSystem(int threads);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int threadCount() const { return threadCount_; }
+
+    // Calls body(begin, end) over [0, count) in chunks of chunkSize, from any of the threads, and waits for all of
+    // them. Chunks must not depend on each other.
+    void parallelFor(int count, int chunkSize, const std::function<void(int begin, int end)>& body);
+
+private:
+    struct Job {
+        const std::function<void(int, int)>* body;
+        int begin;
+        int end;
+        std::atomic<int>* remaining;
+    };
+
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<Job> jobs;
+    };
+
+    bool takeJob(int self, Job& job);
+    void runJob(const Job& job);
+    void workerLoop(int self);
+
+    int threadCount_;
+    std::unique_ptr<WorkQueue[]> queues_;       // one per thread, index 0 is the caller of parallelFor
+    std::vector<std::thread> workers_;
+    std::mutex sleepLock_;
+    std::condition_variable wake_;
+    std::atomic<int> queued_{0};                // chunks pushed and not yet taken
+    bool stop_ = false;
+};
+
+#endif //JOB_SYSTEM_H
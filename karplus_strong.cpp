@@ -0,0 +1,214 @@
+#include "karplus_strong.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    constexpr float KS_SILENCE = 1e-8f;             // mean energy per frame below which a string is silent
+    constexpr float KS_BASE_DECAY_SECONDS = 4.0f;   // time to -60 dB for a string at 100 Hz
+    constexpr float KS_NOISE = 0.15f;               // share of noise mixed into the pluck shape, adds brightness
+
+    typedef float LaneVector __attribute__((vector_size(KS_LANES * sizeof(float))));
+
+    float NextNoise(uint32_t& seed) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f;
+    }
+
+    inline void LoadLanes(LaneVector& v, const float* src) {
+        std::memcpy(&v, src, sizeof(v));
+    }
+
+    inline void StoreLanes(float* dst, const LaneVector& v) {
+        std::memcpy(dst, &v, sizeof(v));
+    }
+
+    // Runs one group of KS_LANES strings for frames samples and accumulates them into acc, lane by lane. Reading
+    // and writing the delay lines is a per-lane gather/scatter; the loop filters, decay and gain are vector ops.
+    __attribute__((always_inline)) inline void RenderGroup(StringBank& bank, const int first, LaneVector* acc, const int frames) {
+        float* lines[KS_LANES];
+        int index[KS_LANES];
+        int length[KS_LANES];
+        for (int l = 0; l < KS_LANES; ++l) {
+            lines[l] = &bank.delay[(first + l) * KS_MAX_DELAY];
+            index[l] = bank.index[first + l];
+            length[l] = std::max(bank.length[first + l], 1);
+        }
+
+        LaneVector loss, coeff, gain, allpassIn, allpassOut, previous;
+        LoadLanes(loss, &bank.loss[first]);
+        LoadLanes(coeff, &bank.allpassCoeff[first]);
+        LoadLanes(gain, &bank.gain[first]);
+        // A string that decayed in a group that is still sounding keeps being stepped with its neighbours, but is
+        // not heard any more
+        for (int l = 0; l < KS_LANES; ++l) {
+            if (!bank.active[first + l]) gain[l] = 0.0f;
+        }
+        LoadLanes(allpassIn, &bank.allpassIn[first]);
+        LoadLanes(allpassOut, &bank.allpassOut[first]);
+        LoadLanes(previous, &bank.previous[first]);
+        loss *= 0.5f;
+        LaneVector energy = {};
+
+        for (int i = 0; i < frames; ++i) {
+            LaneVector current;
+            for (int l = 0; l < KS_LANES; ++l) current[l] = lines[l][index[l]];
+
+            const LaneVector averaged = loss * (current + previous);
+            previous = current;
+            const LaneVector tuned = coeff * averaged + allpassIn - coeff * allpassOut;
+            allpassIn = averaged;
+            allpassOut = tuned;
+
+            for (int l = 0; l < KS_LANES; ++l) {
+                lines[l][index[l]] = tuned[l];
+                if (++index[l] == length[l]) index[l] = 0;
+            }
+
+            acc[i] += current * gain;
+            energy += current * current;
+        }
+
+        StoreLanes(&bank.allpassIn[first], allpassIn);
+        StoreLanes(&bank.allpassOut[first], allpassOut);
+        StoreLanes(&bank.previous[first], previous);
+        for (int l = 0; l < KS_LANES; ++l) {
+            bank.index[first + l] = index[l];
+            if (energy[l] < KS_SILENCE * frames) bank.active[first + l] = 0;
+        }
+    }
+
+    __attribute__((always_inline)) inline void RenderBankKernel(StringBank& bank, float* out, const int frames) {
+        const int padded = static_cast<int>(bank.gain.size());
+        LaneVector acc[KS_BLOCK];
+
+        for (int start = 0; start < frames; start += KS_BLOCK) {
+            const int n = std::min(KS_BLOCK, frames - start);
+            for (int i = 0; i < n; ++i) acc[i] = LaneVector{};
+
+            for (int first = 0; first < padded; first += KS_LANES) {
+                bool sounding = false;
+                for (int l = 0; l < KS_LANES; ++l) sounding |= bank.active[first + l] != 0;
+                if (sounding) RenderGroup(bank, first, acc, n);
+            }
+
+            for (int i = 0; i < n; ++i) {
+                float sum = 0.0f;
+                for (int l = 0; l < KS_LANES; ++l) sum += acc[i][l];
+                out[start + i] += sum;
+            }
+        }
+    }
+
+    void RenderBankGeneric(StringBank& bank, float* out, const int frames) {
+        RenderBankKernel(bank, out, frames);
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2"))) void RenderBankAvx2(StringBank& bank, float* out, const int frames) {
+        RenderBankKernel(bank, out, frames);
+    }
+
+    bool CpuHasAvx2() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+#else
+    void RenderBankAvx2(StringBank& bank, float* out, const int frames) {
+        RenderBankKernel(bank, out, frames);
+    }
+
+    bool CpuHasAvx2() {
+        return false;
+    }
+#endif
+
+    StringBankKernel DetectKernel() {
+        return CpuHasAvx2() ? KS_KERNEL_AVX2 : KS_KERNEL_GENERIC;
+    }
+
+    StringBankKernel kernel = DetectKernel();
+}
+
+void InitStringBank(StringBank& bank, const int strings) {
+    const int padded = (strings + KS_LANES - 1) / KS_LANES * KS_LANES;
+    bank.count = strings;
+    bank.delay.assign(padded * KS_MAX_DELAY, 0.0f);
+    bank.length.assign(padded, 1);
+    bank.index.assign(padded, 0);
+    bank.loss.assign(padded, 0.0f);
+    bank.allpassCoeff.assign(padded, 0.0f);
+    bank.allpassIn.assign(padded, 0.0f);
+    bank.allpassOut.assign(padded, 0.0f);
+    bank.previous.assign(padded, 0.0f);
+    bank.gain.assign(padded, 0.0f);
+    bank.active.assign(padded, 0);
+}
+
+float ScaleFrequency(const int degree, const float baseFrequency) {
+    static const int majorSteps[7] = {0, 2, 4, 5, 7, 9, 11};
+    const int octave = degree >= 0 ? degree / 7 : (degree - 6) / 7;
+    const int semitones = octave * 12 + majorSteps[degree - octave * 7];
+    return baseFrequency * std::pow(2.0f, semitones / 12.0f);
+}
+
+void ExciteString(StringBank& bank, const int string, const int sampleRate, const float frequency, const float amplitude, const float position, uint32_t& noiseSeed) {
+    if (string < 0 || string >= bank.count) return;
+
+    // Loop delay is length + 0.5 (averaging filter) + d (all-pass), with d kept in [0.5, 1.5) for a stable all-pass
+    const float period = std::min(static_cast<float>(sampleRate) / frequency, static_cast<float>(KS_MAX_DELAY));
+    const int length = std::max(2, static_cast<int>(period - 1.0f));
+    const float fraction = period - 0.5f - length;
+    bank.length[string] = length;
+    bank.allpassCoeff[string] = (1.0f - fraction) / (1.0f + fraction);
+
+    const float decaySeconds = KS_BASE_DECAY_SECONDS * std::sqrt(100.0f / frequency);
+    bank.loss[string] = std::pow(10.0f, -3.0f / (decaySeconds * frequency));
+    bank.gain[string] = amplitude;
+
+    // Triangular displacement peaking where the string was plucked, which is the shape a real string has at
+    // the moment it is released
+    float* line = &bank.delay[string * KS_MAX_DELAY];
+    const float peak = std::min(std::max(position, 0.1f), 0.9f) * length;
+    float mean = 0.0f;
+    for (int i = 0; i < length; ++i) {
+        const float shape = i < peak ? i / peak : (length - i) / (length - peak);
+        line[i] = (1.0f - KS_NOISE) * shape + KS_NOISE * NextNoise(noiseSeed);
+        mean += line[i];
+    }
+    mean /= length;
+    for (int i = 0; i < length; ++i) {
+        line[i] -= mean;
+    }
+
+    bank.index[string] = 0;
+    bank.allpassIn[string] = 0.0f;
+    bank.allpassOut[string] = 0.0f;
+    bank.previous[string] = 0.0f;
+    bank.active[string] = 1;
+}
+
+void RenderStringBank(StringBank& bank, float* out, const int frames) {
+    if (kernel == KS_KERNEL_AVX2) {
+        RenderBankAvx2(bank, out, frames);
+    } else {
+        RenderBankGeneric(bank, out, frames);
+    }
+}
+
+StringBankKernel GetStringBankKernel() {
+    return kernel;
+}
+
+bool SetStringBankKernel(const StringBankKernel requested) {
+    if (requested == KS_KERNEL_AVX2 && !CpuHasAvx2()) return false;
+    kernel = requested;
+    return true;
+}
+
+const char* StringBankKernelName(const StringBankKernel kernel) {
+    switch (kernel) {
+        case KS_KERNEL_AVX2: return "avx2";
+        default: return "generic";
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef KARPLUS_STRONG_H
+#define KARPLUS_STRONG_H
+
+#include <cstdint>
+#include <vector>
+
+constexpr int KS_MAX_DELAY = 2048;          // longest period in samples, ~23 Hz at 48 kHz
+constexpr int KS_LANES = 8;                 // strings processed side by side in one SIMD group
+constexpr int KS_BLOCK = 64;                // frames mixed per block
+constexpr float BASE_FREQUENCY = 130.81f;   // C3; strings go up the major scale from here
+constexpr float MASTER_GAIN = 0.3f;         // applied to the sum of all strings
+
+// Plucked strings as Karplus-Strong delay lines: an averaging low-pass and a loss factor in the loop give the
+// decay and the darker tail, and a first-order all-pass supplies the fractional part of the period so each
+// string stays in tune. State is kept structure-of-arrays, padded to whole groups of KS_LANES strings, so the
+// loop filters, gain and decay of a group run across SIMD lanes. Everything is sized by InitStringBank, so
+// exciting and rendering never allocate.
+struct StringBank {
+    int count = 0;                          // strings in use; the arrays are padded to a multiple of KS_LANES
+    std::vector<float> delay;               // one KS_MAX_DELAY line per string
+    std::vector<int> length;                // integer part of the loop delay
+    std::vector<int> index;
+    std::vector<float> loss;                // gain per trip round the loop
+    std::vector<float> allpassCoeff;
+    std::vector<float> allpassIn;
+    std::vector<float> allpassOut;
+    std::vector<float> previous;
+    std::vector<float> gain;
+    std::vector<unsigned char> active;
+};
+
+enum StringBankKernel {
+    KS_KERNEL_GENERIC,                      // baseline instruction set of the build
+    KS_KERNEL_AVX2
+};
+
+void InitStringBank(StringBank& bank, int strings);
+
+// Frequency of a degree of the major scale above baseFrequency (degree 0 = baseFrequency).
+float ScaleFrequency(int degree, float baseFrequency);
+
+// Re-plucks a string: whatever it was sounding is replaced, like a finger stopping it before plucking again.
+// amplitude is 0..1, position is where along the string (0..1) it was plucked.
+void ExciteString(StringBank& bank, int string, int sampleRate, float frequency, float amplitude, float position, uint32_t& noiseSeed);
+
+// Adds frames samples of every sounding string to out. Groups whose strings have all decayed are skipped, and
+// decayed strings in the other groups are muted.
+void RenderStringBank(StringBank& bank, float* out, int frames);
+
+// The kernel is picked from the CPU features during static initialisation, before main; forcing one is for
+// benchmarks. Returns false if the CPU cannot run it.
+StringBankKernel GetStringBankKernel();
+bool SetStringBankKernel(StringBankKernel kernel);
+const char* StringBankKernelName(StringBankKernel kernel);
+
+#endif //KARPLUS_STRONG_H
@@ -1,317 +1,97 @@
 #include <iostream>
 #include "raylib.h"
-#include "reasings.h"
+#include "rlgl.h"
+#include "harp.h"
+#include "texture_cache.h"
+#include "audio_engine.h"
+#include "karplus_strong.h"
+#include "job_system.h"
+#include "asset_loader.h"
+#include "input_recording.h"
+#include "midi.h"
+#include "profiler.h"
 #include <thread>
 #include <stdlib.h>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
 
 using std::to_string;
 using std::cout;
 using std::endl;
 
-constexpr int screenWidth = 1400;
-constexpr int screenHeight = 850;
-constexpr float MAX_CORD_SIZE = 6.0f;
-constexpr float MIN_CORD_SIZE = 2.0f;
-constexpr float MAX_CORD_LENGTH = 320.0f;
-constexpr float MIN_CORD_LENGTH = 320.0f;
-constexpr int MAX_SOUNDS = 400;
-constexpr int CHORDS = 10;
-constexpr float MAX_PITCH = 1.0f;
-constexpr float MIN_PITCH = 0.4f;
-constexpr float SHADOW_HEIGHT = 10.0f;
 constexpr float SHADOW_THICKNESS = 0.15f;
 constexpr float SHADOW_SIZE = 20.0f;
-constexpr int PLUCK_THRESHOLD = 30;
-constexpr Vector2 bow = {25, 300};
+constexpr int TRAIL_RIBBON_POINTS = 96;
+constexpr float TRAIL_WIDTH = 30.0f;
+constexpr float TRAIL_ALPHA = 0.6f;
+constexpr int TARGET_FPS = 60;
+constexpr int AUDIO_BUFFER_FRAMES = 256;       // default audio latency/CPU trade-off, one buffer of scheduling delay
+constexpr int MIN_AUDIO_BUFFER_FRAMES = 32;    // below this the callback runs too often to keep up
+constexpr int MAX_AUDIO_BUFFER_FRAMES = 8192;
+
+// Command line switches, see main
+struct LaunchOptions {
+    const char* profileCsv = nullptr;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* eventLogPath = nullptr;
+    const char* midiOutPath = nullptr;
+    const char* midiInPath = nullptr;
+    int audioBufferFrames = AUDIO_BUFFER_FRAMES;
+    bool replayFast = false;
+};
 
-void sleep(const int ms) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-}
 template <typename T>
 void print(T value, std::string name = "value") {
     std::cout << name << ": " << value << std::endl;
 }
 
-Sound soundArray[MAX_SOUNDS] = { 0 };
-int currentSound;
-
-struct Animation {
-    float currTime;
-    float duration;
-    Vector2 startPosition;
-    Vector2 endPosition;
-    float (*AnimationFunc)(float t, float b, float c, float d);
-
-
-    Animation() = default;
-
-    Animation(int i, int i1, Vector2 start_position, Vector2 end_position, float(* animationfunc)(float t, float b, float c, float d))
-        : currTime(i), duration(i1), startPosition(start_position), endPosition(end_position), AnimationFunc(animationfunc) {}
-};
-struct Chord {
-    std::array<Vector2, 5> points;
-    Animation anim;
-    bool grab = false;
-    bool canBeGrabbed = true;
-    Vector2 grabPoint = {0,0};
-
-    Chord(std::array<Vector2, 5> points_, const Animation &anim_) : points(points_), anim(anim_) {}
-};
-
-std::vector<Chord> chords;
-std::vector<Chord> chordShadows;
-
-Vector2 cursorPosition = {0, 0};
-std::queue<Vector2> cursorQueue;
-
-float SpringOut(int currentTime, float startValue, float changeInValue, int duration) {
-    if (currentTime >= duration) return startValue + changeInValue;
-
-    float t = static_cast<float>(currentTime) / duration; // Normalize time to [0, 1]
-    float frequency = 4.0f;  // Number of oscillations
-    float damping = 2.0f;    // Controls how fast oscillations decay
-
-    return startValue + changeInValue * (1.0f - std::exp(-damping * t) * std::cos(frequency * M_PI * t));
-}
-
-void handleChordInteraction(Chord& chord, int index) {
-    const float cordLen = chord.points[4].x - chord.points[0].x;
-    const int sideThreshold = cordLen/6;
-    if (abs(GetMousePosition().y - chord.anim.endPosition.y) <= 10
-        && (GetMousePosition().x >= chord.points[0].x + sideThreshold
-            && GetMousePosition().x <= chord.points[4].x - sideThreshold)) {
-        chord.grab = true;
-    }
-    if (chord.grab){
-        chord.anim.currTime = 0.0f;
-        if (abs(GetMousePosition().y - chord.anim.endPosition.y) <= PLUCK_THRESHOLD) {
-            if ((GetMousePosition().x >= chord.points[0].x + sideThreshold && GetMousePosition().x <= chord.points[4].x - sideThreshold)) {
-                chord.points[2].x = GetMousePosition().x;
-                chord.points[2].y = GetMousePosition().y;
-            } else {
-                chord.grab = false;
-            }
-        } else {
-            const float pitch_rate = (MAX_PITCH - MIN_PITCH) / (CHORDS - 1);
-            const float pitch = 1.0f * MIN_PITCH + (pitch_rate * (index));
-            SetSoundPitch(soundArray[currentSound], pitch);
-            PlaySound(soundArray[currentSound]);            // play the next open sound slot
-            currentSound++;                                 // increment the sound slot
-            if (currentSound >= MAX_SOUNDS)                 // if the sound slot is out of bounds, go back to 0
-                currentSound = 0;
-            chord.grab = false;
-            chord.anim.startPosition = {chord.points[2].x, chord.points[2].y};
-        }
-    } else {
-        if (chord.anim.currTime < chord.anim.duration) {
-            chord.anim.currTime += GetFrameTime() * 100.0f;  // Adjust speed
-
-            // Apply the easing function
-            const float valy = chord.anim.AnimationFunc(chord.anim.currTime, chord.anim.startPosition.y, chord.anim.endPosition.y - chord.anim.startPosition.y, chord.anim.duration);
-            chord.points[2].y = valy;
-        }
-
-        if (chord.points[2].x != chord.anim.endPosition.x) {
-            const float valx = chord.anim.AnimationFunc(chord.anim.currTime, chord.anim.startPosition.x, chord.anim.endPosition.x - chord.anim.startPosition.x, chord.anim.duration);
-            chord.points[2].x = valx;
-        }
-    }
-}
-
-void handleChordInteractionTrail(Chord& chord, int index) {
-    if (cursorQueue.size() < 2) return;
-    std::queue<Vector2> copyQueue(cursorQueue);
-    while (!copyQueue.empty()) {
-        const float cordLen = chord.points[4].x - chord.points[0].x;
-        const int sideThreshold = cordLen/6;
-        if (abs(cursorQueue.front().y - chord.anim.endPosition.y) <= 10
-            && (cursorQueue.front().x >= chord.points[0].x + sideThreshold
-                && cursorQueue.front().x <= chord.points[4].x - sideThreshold)) {
-            chord.grab = true;
-                }
-        if (chord.grab){
-            chord.anim.currTime = 0.0f;
-            if (abs(cursorQueue.front().y - chord.anim.endPosition.y) <= PLUCK_THRESHOLD) {
-                if ((cursorQueue.front().x >= chord.points[0].x + sideThreshold && cursorQueue.front().x <= chord.points[4].x - sideThreshold)) {
-                    chord.points[2].x = cursorQueue.front().x;
-                    chord.points[2].y = cursorQueue.front().y;
-                } else {
-                    chord.grab = false;
-                }
-            } else {
-                const float pitch_rate = (MAX_PITCH - MIN_PITCH) / (CHORDS - 1);
-                const float pitch = 1.0f * MIN_PITCH + (pitch_rate * (index));
-                SetSoundPitch(soundArray[currentSound], pitch);
-                PlaySound(soundArray[currentSound]);            // play the next open sound slot
-                currentSound++;                                 // increment the sound slot
-                if (currentSound >= MAX_SOUNDS)                 // if the sound slot is out of bounds, go back to 0
-                    currentSound = 0;
-                chord.grab = false;
-                chord.anim.startPosition = {chord.points[2].x, chord.points[2].y};
-            }
-        } else {
-            if (chord.anim.currTime < chord.anim.duration) {
-                chord.anim.currTime += GetFrameTime() * 1.0f;  // Adjust speed
-
-                // Apply the easing function
-                const float valy = chord.anim.AnimationFunc(chord.anim.currTime, chord.anim.startPosition.y, chord.anim.endPosition.y - chord.anim.startPosition.y, chord.anim.duration);
-                chord.points[2].y = valy;
-            }
-
-            if (chord.points[2].x != chord.anim.endPosition.x) {
-                const float valx = chord.anim.AnimationFunc(chord.anim.currTime, chord.anim.startPosition.x, chord.anim.endPosition.x - chord.anim.startPosition.x, chord.anim.duration);
-                chord.points[2].x = valx;
-            }
-        }
-        copyQueue.pop();
-    }
-}
-
-void handleChordInteractionBow(Chord& chord, int index) {
-    const float cordLen = chord.points[4].x - chord.points[0].x;
-    const int sideThreshold = cordLen/6;
-    if (chord.anim.endPosition.y >= GetMouseY() && chord.anim.endPosition.y <= GetMouseY() + bow.y
-        && (GetMouseX() >= chord.points[0].x + sideThreshold
-        && GetMouseX() + bow.x <= chord.points[4].x - sideThreshold)) {
-        if (chord.canBeGrabbed) {
-            chord.grab = true;
-            chord.canBeGrabbed = false;
-            chord.grabPoint = {bow.x/2, abs(GetMouseY() - chord.anim.endPosition.y)};
-        }
-    } else {
-        chord.canBeGrabbed = true;
-    }
-    if (chord.grab){
-        chord.anim.currTime = 0.0f;
-        if (abs(GetMouseY() + chord.grabPoint.y - chord.anim.endPosition.y) <= PLUCK_THRESHOLD) {
-            if ((GetMouseX() + chord.grabPoint.x >= chord.points[0].x + sideThreshold && GetMouseX() + chord.grabPoint.x <= chord.points[4].x - sideThreshold)) {
-                chord.points[2].x = GetMouseX() + chord.grabPoint.x;
-                chord.points[2].y = GetMouseY() + chord.grabPoint.y;
-            } else {
-                chord.grab = false;
-            }
-        } else {
-            const float pitch_rate = (MAX_PITCH - MIN_PITCH) / (CHORDS - 1);
-            const float pitch = 1.0f * MIN_PITCH + (pitch_rate * (index));
-            SetSoundPitch(soundArray[currentSound], pitch);
-            PlaySound(soundArray[currentSound]);            // play the next open sound slot
-            currentSound++;                                 // increment the sound slot
-            if (currentSound >= MAX_SOUNDS)                 // if the sound slot is out of bounds, go back to 0
-                currentSound = 0;
-            chord.grab = false;
-            chord.anim.startPosition = {chord.points[2].x, chord.points[2].y};
-        }
-    } else {
-        if (chord.anim.currTime < chord.anim.duration) {
-            chord.anim.currTime += GetFrameTime() * 50.0f;  // Adjust speed
-
-            // Apply the easing function
-            const float valy = chord.anim.AnimationFunc(chord.anim.currTime, chord.anim.startPosition.y, chord.anim.endPosition.y - chord.anim.startPosition.y, chord.anim.duration);
-            chord.points[2].y = valy;
-        }
-
-        if (chord.points[2].x != chord.anim.endPosition.x) {
-            const float valx = chord.anim.AnimationFunc(chord.anim.currTime, chord.anim.startPosition.x, chord.anim.endPosition.x - chord.anim.startPosition.x, chord.anim.duration);
-            chord.points[2].x = valx;
-        }
-    }
+void sleep(const int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
-void addChords(const int amount) {
-    const float verticalMargin = 130.0f;
-    const float height_rate = ((screenHeight - verticalMargin) - verticalMargin) / (amount - 1);
-    print(height_rate);
-    for (int i = 0; i < amount; ++i) {
-        const auto height = static_cast<float>(verticalMargin + (height_rate * i));
-        const float length_rate = (MAX_CORD_LENGTH - MIN_CORD_LENGTH) / (amount - 1);
-        const float length = 1.0f * MAX_CORD_LENGTH - (length_rate * (i));
-
-        const float finalStartX = (screenWidth - length)/2;
-        const float finalEndX = screenWidth - finalStartX;
-        std::array<Vector2, 5> points = {
-            Vector2{finalStartX, height},
-            Vector2{finalStartX, height},
-            Vector2{screenWidth/2, height},
-            Vector2{finalEndX, height},
-            Vector2{finalEndX, height }
-        };
-        const float shadowDistance = 5.0f;
-        std::array<Vector2, 5> shadows = {
-            Vector2{finalStartX, height},
-            Vector2{finalStartX, height},
-            Vector2{screenWidth/2, height + shadowDistance},
-            Vector2{finalEndX, height},
-            Vector2{finalEndX, height }
-        };
-
-        Vector2 startPosition = {points[2].x, points[2].y};
-        Vector2 endPosition = {screenWidth/2 , points[0].y};
-
-        Animation myAnim(0.0f, 50.0f, startPosition, endPosition, EaseElasticOut);
-        Chord myChord(points, myAnim);
-        Chord myShadow(shadows, myAnim);
-        chords.push_back(myChord);
-        chordShadows.push_back(myShadow);
+Harp harp;
+
+// Submits a whole strip as textured quads in one batch, so it costs a single draw call instead of one per sample.
+void DrawStringStrip(const std::vector<Vector2>& strip, const std::vector<float>& texCoords, Texture2D texture, Color tint) {
+    if (strip.size() < 4) return;
+
+    rlCheckRenderBatchLimit((strip.size()/2 - 1) * 4);
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (size_t i = 0; i + 3 < strip.size(); i += 2) {
+        const float u0 = texCoords[i/2];
+        const float u1 = texCoords[i/2 + 1];
+        rlTexCoord2f(u0, 0.0f); rlVertex2f(strip[i].x, strip[i].y);
+        rlTexCoord2f(u0, 1.0f); rlVertex2f(strip[i + 1].x, strip[i + 1].y);
+        rlTexCoord2f(u1, 1.0f); rlVertex2f(strip[i + 3].x, strip[i + 3].y);
+        rlTexCoord2f(u1, 0.0f); rlVertex2f(strip[i + 2].x, strip[i + 2].y);
     }
+    rlEnd();
+    rlSetTexture(0);
+    CountDrawCalls(1);
 }
 
-float GetSplineAngle(Vector2 p1, Vector2 p2, Vector2 p3, Vector2 p4, float t, float dt = 0.01f) {
-    // Get two close points along the spline
-    Vector2 P1 = GetSplinePointCatmullRom(p1, p2, p3, p4, t);
-    Vector2 P2 = GetSplinePointCatmullRom(p1, p2, p3, p4, t + dt);
-
-    // Compute the direction vector
-    Vector2 dir = { P2.x - P1.x, P2.y - P1.y };
-
-    // Compute the angle in radians and convert to degrees
-    return atan2f(dir.y, dir.x) * RAD2DEG;
-}
-
-float InverseParabola(const int x) {
-    const auto flx = static_cast<float>(x);
-    const float func = -1.0f * std::pow((flx-20.0f)/4.5f, 2.0f) + 20.0f;
-    if (func > 0) return func;
-    return 0;
-}
-
-float ParabolaSecondPhase(const int x, const float max_input, const float max_output) {
-    const auto flx = static_cast<float>(x);
-    const float z = 0.225f * max_input * (0.01818f * max_output * -1.0f + 1.3636f);
-    const float func = -1.0f * std::pow(flx/z,2.0f) + max_output;
-    if (func > 0) return func;
-    return 0;
-}
-
-
 void drawChords(Texture2D textureString, Texture2D textureBolt, Texture2D shadow_string, Texture2D shadow_bolt) {
-    const float sizeRate = (MAX_CORD_SIZE - MIN_CORD_SIZE) / (chords.size() - 1);
-
-    for (int i = 0; i < chords.size(); ++i) {
-        const int cordLength = chords.at(i).points.data()[4].x - chords.at(i).points.data()[0].x;
-        const float cordSize = MAX_CORD_SIZE - (i * sizeRate);
-        textureString.height = cordSize;
-        shadow_string.height = cordSize * 6;
+    const ChordBank& chords = harp.chords;
+    for (int i = 0; i < chords.count; ++i) {
+        const StringMesh& mesh = chords.meshes[i].strips;
+        const float restY = chords.rest[i].y;
+        const float cordSize = chords.thickness[i];
         const int textureBoltSizeFactor = 15;
         textureBolt.height = cordSize + textureBoltSizeFactor;
         textureBolt.width = cordSize + textureBoltSizeFactor;
         shadow_bolt.height = textureBolt.height;
         shadow_bolt.width = textureBolt.width;
 
-
-
-        // Use transparent color for the spline
-        // DrawSplineCatmullRom(chords.at(i).points.data(), 5, cordSize, Fade(WHITE, 0.0f)); // Fully transparent
-        //shadows
-        // DrawSplineCatmullRom(chordShadows.at(i).points.data(), 5, cordSize + 5, Fade(BLACK, 0.5f));
-
-        const int numTextures = 80;  // Number of textures along the spline
-        textureString.width = cordLength / numTextures + 10;
-        int numSegments = 5 - 3;      // Catmull-Rom requires at least 4 points per segment
-
-        const float bolt1x = (chords.at(i).points[0].x - textureBolt.width/2) - 10;
-        const float bolt1y = (chords.at(i).points[0].y - textureBolt.height/2);
+        const float bolt1x = (chords.left[i] - textureBolt.width/2) - 10;
+        const float bolt1y = (restY - textureBolt.height/2);
         DrawTexturePro(shadow_bolt,
     {0,0, (float)shadow_bolt.width, (float)shadow_bolt.height},
     {bolt1x + 13, bolt1y - 25, (float)shadow_bolt.width * 5 + cordSize, (float)shadow_bolt.height * 3},
@@ -319,45 +99,13 @@ void drawChords(Texture2D textureString, Texture2D textureBolt, Texture2D shadow
     60.0f,
     Fade(BLACK, 0.7f));
 
-        for (int seg = 0; seg < numSegments; ++seg) {
-            Vector2 p1 = chords[i].points[seg];
-            Vector2 p2 = chords[i].points[seg + 1];
-            Vector2 p3 = chords[i].points[seg + 2];
-            Vector2 p4 = chords[i].points[seg + 3];
-
-            const int textureSegments = (numTextures / numSegments)/3 * cordSize;
-
-            for (int j = 0; j < textureSegments; ++j) {
-                float t = (float)j / (textureSegments - 1); // Normalize t per segment
-
-                // Get the interpolated position on the current spline segment
-                Vector2 point = GetSplinePointCatmullRom(p1, p2, p3, p4, t);
-                float angle = GetSplineAngle(p1, p2, p3, p4, t);
-
-                //invert the shadow function if we are at the second run of the loop
-                float x = seg == 0 ? textureSegments - j : j;
-
-               DrawTexturePro(shadow_string,
-               {0, 0, (float)shadow_string.width, (float)shadow_string.height }, // Source rect
-               {point.x, point.y + ParabolaSecondPhase(x, textureSegments, SHADOW_HEIGHT), (float)shadow_string.width, (float)shadow_string.height}, // Dest rect
-               {(float)shadow_string.width / 2, (float)shadow_string.height / 2}, // Origin (centered)
-               angle, // Rotation angle
-               Fade(BLACK, SHADOW_THICKNESS));
-
-                // Draw the texture centered at the spline point
-                DrawTexturePro(textureString,
-               {0, 0, (float)textureString.width, (float)textureString.height}, // Source rect
-               {point.x, point.y, (float)textureString.width, (float)textureString.height}, // Dest rect
-               {(float)textureString.width / 2, (float)textureString.height / 2}, // Origin (centered)
-               angle, // Rotation angle
-               WHITE);
-            }
-        }
+        DrawStringStrip(mesh.shadowStrip, mesh.texCoords, shadow_string, Fade(BLACK, SHADOW_THICKNESS));
+        DrawStringStrip(mesh.stringStrip, mesh.texCoords, textureString, WHITE);
 
         DrawTexture(textureBolt, bolt1x, bolt1y, WHITE);
 
-        const float bolt2x = (chords.at(i).points[4].x - textureBolt.width/2) + 10;
-        const float bolt2y = (chords.at(i).points[4].y - textureBolt.height/2);
+        const float bolt2x = (chords.right[i] - textureBolt.width/2) + 10;
+        const float bolt2y = (restY - textureBolt.height/2);
         DrawTexturePro(shadow_bolt,
             {0,0, (float)shadow_bolt.width, (float)shadow_bolt.height},
             {bolt2x + 13, bolt2y - 25, (float)shadow_bolt.width * 5 + cordSize, (float)shadow_bolt.height * 3},
@@ -365,22 +113,60 @@ void drawChords(Texture2D textureString, Texture2D textureBolt, Texture2D shadow
             60.0f,
             Fade(BLACK, 0.7f));
         DrawTexture(textureBolt, bolt2x, bolt2y, WHITE);
+        CountDrawCalls(4);      // bolts and their shadows; the strips count themselves
     }
 }
 
-Texture2D CreateShadowFromTexture(Texture2D texture) {
-    Image stringImage = LoadImageFromTexture(texture);
-    ImageResizeCanvas(&stringImage, texture.width * 2, texture.height * 2, texture.width/2, texture.height/2, Fade(BLACK, 0.0f));
-    ImageBlurGaussian(&stringImage, SHADOW_SIZE);
-    ImageResize(&stringImage, texture.width, texture.height);
-    UnloadImage(stringImage);
-    return LoadTextureFromImage(stringImage);
+// One direction of the separable blur: draws source into target through blur.fs. Render textures come out
+// upside down, so the source is drawn with a flipped source rectangle to keep every pass the same way up.
+void BlurPass(RenderTexture2D source, RenderTexture2D target, Shader blurShader, Vector2 direction) {
+    SetShaderValue(blurShader, GetShaderLocation(blurShader, "direction"), &direction, SHADER_UNIFORM_VEC2);
+
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);    // plain copy onto the cleared target, keeps the blurred alpha intact
+    BeginShaderMode(blurShader);
+    DrawTextureRec(source.texture, {0, 0, (float)source.texture.width, -(float)source.texture.height}, {0, 0}, WHITE);
+    EndShaderMode();
+    EndBlendMode();
+    EndTextureMode();
 }
 
-Texture2D StretchTexture(Texture2D texture, float factor) {
-    Image textureImage = LoadImageFromTexture(texture);
-    ImageResizeNN(&textureImage, textureImage.width * factor * 2, textureImage.height * factor);
-    return LoadTextureFromImage(textureImage);
+// Places the texture in the middle of a transparent canvas twice its size, blurs it by SHADOW_SIZE on the GPU and
+// scales the result into a width x height render texture. No CPU readback, so shadows can be regenerated at runtime.
+RenderTexture2D CreateShadowFromTexture(Texture2D texture, Shader blurShader, int width, int height) {
+    RenderTexture2D canvas = LoadRenderTexture(texture.width * 2, texture.height * 2);
+    RenderTexture2D pingPong = LoadRenderTexture(texture.width * 2, texture.height * 2);
+    const RenderTexture2D shadow = LoadRenderTexture(width, height);
+
+    const float radius = SHADOW_SIZE;
+    SetShaderValue(blurShader, GetShaderLocation(blurShader, "radius"), &radius, SHADER_UNIFORM_FLOAT);
+
+    BeginTextureMode(canvas);
+    ClearBackground(BLANK);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexture(texture, texture.width/2, texture.height/2, WHITE);
+    EndBlendMode();
+    EndTextureMode();
+
+    BlurPass(canvas, pingPong, blurShader, {1.0f / canvas.texture.width, 0.0f});
+    BlurPass(pingPong, canvas, blurShader, {0.0f, 1.0f / canvas.texture.height});
+
+    // Unflipped source here, so the final texture ends up the right way up for regular DrawTexture calls
+    SetTextureFilter(canvas.texture, TEXTURE_FILTER_BILINEAR);
+    BeginTextureMode(shadow);
+    ClearBackground(BLANK);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(canvas.texture,
+        {0, 0, (float)canvas.texture.width, (float)canvas.texture.height},
+        {0, 0, (float)width, (float)height},
+        {0, 0}, 0.0f, WHITE);
+    EndBlendMode();
+    EndTextureMode();
+
+    UnloadRenderTexture(canvas);
+    UnloadRenderTexture(pingPong);
+    return shadow;
 }
 
 void DrawTextureRounded(Texture2D texture, Shader roundedMaskShader, Rectangle destRec, float roundness, Color tint) {
@@ -401,14 +187,9 @@ void DrawTextureRounded(Texture2D texture, Shader roundedMaskShader, Rectangle d
     EndShaderMode();
 }
 
-void DrawRoundedRectangleWithShadow(Rectangle rect, int size, float roundness, float shadowOpacity, Shader roundedMaskShader) {
-    Image shadow_image = GenImageColor(rect.width, rect.height, Fade(BLACK, shadowOpacity));
-    Image* img = &shadow_image;
-    ImageBlurGaussian(img, size);
-
-    Texture2D texture = LoadTextureFromImage(shadow_image);
+void DrawRoundedRectangleWithShadow(TextureCache& cache, Rectangle rect, int size, float roundness, float shadowOpacity, Shader roundedMaskShader) {
+    const Texture2D texture = GetCachedBlurredRect(cache, rect.width, rect.height, size, shadowOpacity);
     DrawTextureRounded(texture, roundedMaskShader, rect, roundness, WHITE);
-
 }
 
 void DrawTextureRoundedBeveled(Texture2D texture, Shader roundedMaskShader, Rectangle destRec, float roundness, Color tint, float bevelHeight, float viewAngle) {
@@ -427,62 +208,34 @@ void DrawTextureRoundedBeveled(Texture2D texture, Shader roundedMaskShader, Rect
 
 void HandleSound() {
     if (IsKeyPressed(KEY_SPACE)) {
-        PlaySound(soundArray[currentSound]);            // play the next open sound slot
-        currentSound++;                                 // increment the sound slot
-        if (currentSound >= MAX_SOUNDS)                 // if the sound slot is out of bounds, go back to 0
-            currentSound = 0;          // play the next open sound slot
+        QueueNoteOn(CHORDS - 1, ScaleFrequency(CHORDS - 1, BASE_FREQUENCY), 1.0f, 0.5f, GetAudioClock());
     }
-}
-
-void InitSound(Sound sound) {
-    soundArray[0] = sound; // Load WAV audio file into the first slot as the 'source' sound
-    for (int i = 1; i < MAX_SOUNDS; i++)
-    {
-        soundArray[i] = LoadSoundAlias(soundArray[0]);
+    if (IsKeyPressed(KEY_L)) {
+        SetLatencyMeasurement(!IsLatencyMeasurementEnabled());
     }
-    currentSound = 0;
-}
-
-void DrawCursor() {
-    DrawCircle(cursorPosition.x, cursorPosition.y, 15.0f, RED);
+    LogAudioLatency();
 }
 
-void HandleCursor() {
-    const float mx = GetMouseX();
-    const float my = GetMouseY();
-    const Vector2 back = cursorQueue.back();
-    const float max = std::max(abs(mx-back.x), abs(my-back.y));
-    if (abs(mx-back.x) > abs(my-back.y)) {
-        for (int i = back.x; i < mx; mx < back.x ? --i : ++i) {
-            cursorQueue.push({static_cast<float>(i), static_cast<float>(std::min(back.y + (i - back.x), my))});
-        }
-    } else if (abs(mx-back.x) < abs(my-back.y)) {
-        for (int i = back.y; i < my; my < back.y ? --i : ++i) {
-            cursorQueue.push({static_cast<float>(std::min(back.x + (i - back.y), mx)), static_cast<float>(i)});
-        }
-    } else {
-        for (int i = back.x; i < max; ++i) {
-            cursorQueue.push({static_cast<float>(i), static_cast<float>(i)});
-        }
+// P shows the frame profile overlay. Profiling stays on while the overlay is up or a CSV dump is being written.
+void HandleProfiler(bool& showProfile, const bool dumpingCsv) {
+    if (IsKeyPressed(KEY_P)) {
+        showProfile = !showProfile;
+        SetProfiling(showProfile || dumpingCsv);
     }
+}
 
-    if (!cursorQueue.empty()) {
-        if (cursorPosition.x > cursorQueue.front().x) {
-            cursorPosition.x--;
-        } else {
-            cursorPosition.x++;
-        }
-
-        if (cursorPosition.y > cursorQueue.front().y) {
-            cursorPosition.y--;
-        } else {
-            cursorPosition.y++;
-        }
-        if (abs(cursorPosition.x - cursorQueue.front().x) <= 6.0f && abs(cursorPosition.y - cursorQueue.front().y) <= 6.0f) {
-            cursorQueue.pop();
-        }
+// Mouse, frame time and every finger on the touchscreen
+HarpInput ReadInput() {
+    HarpInput input = {GetMousePosition(), GetFrameTime()};
+    input.touchCount = std::min(GetTouchPointCount(), MAX_TOUCH_POINTS);
+    for (int t = 0; t < input.touchCount; ++t) {
+        input.touches[t] = {GetTouchPointId(t), GetTouchPosition(t)};
     }
+    return input;
+}
 
+void DrawCursor() {
+    DrawCircle(harp.cursorPosition.x, harp.cursorPosition.y, 15.0f, RED);
 }
 
 void DrawBow() {
@@ -490,166 +243,330 @@ void DrawBow() {
 }
 
 void DrawTrailCursor() {
-    // for (int i = 0; i < cursorQueue.size(); ++i) {
-    //     DrawCircle(cursorQueue.front().x, cursorQueue.front().y, 10.0f, GREEN);
+    // for (int i = 0; i < harp.cursorTrail.size(); ++i) {
+    //     DrawCircle(harp.cursorTrail[i].position.x, harp.cursorTrail[i].position.y, 10.0f, GREEN);
     // }
     DrawCircle(GetMouseX(), GetMouseY(), 15.0f, RED);
 }
 
-float V2Distance(Vector2 one, Vector2 two) {
-    return sqrtf(powf(one.x - two.x, 2) + powf(one.y - two.y, 2));
+// Trail sample under ribbon point k of count, the newest sample always being the last point
+const PointerSample& TrailRibbonSample(const int k, const int count, const int stride) {
+    return harp.cursorTrail[harp.cursorTrail.size() - 1 - (count - 1 - k) * stride];
 }
 
-float Lerp(float a, float b, float t) {
-    return a + t * (b - a);
-}
-
-void HandleTrailCursor() {
-    if (GetMouseX() == 0 && GetMouseY() == 0) return;
-    if (cursorQueue.size() > 2) {
-        Vector2 prev = cursorQueue.back();
-        float distance = V2Distance(prev, {(float)GetMouseX(), (float)GetMouseY()});
-        int steps = (int)distance; // One circle per pixel distance
-
-        for (int j = 0; j <= steps; j++) {
-            const float t = (float)j / steps; // Interpolation factor
-            Vector2 interpolated = {
-                Lerp(prev.x, GetMouseX(), t),
-                Lerp(prev.y, GetMouseY(), t)
-            };
-            cursorQueue.push(interpolated);
-        }
-    }
-    cursorQueue.push({(float)GetMouseX(), (float)GetMouseY()});
-    if (cursorQueue.size() > 40) {
-        for (int i = 0; i < 40; ++i) {
-            cursorQueue.pop();
-        }
-    }
+// Both edges of the ribbon at point k, across the direction of the trail there. Width and alpha shrink with the age of
+// the sample, so the tail thins out and fades.
+void TrailRibbonEdges(const int k, const int count, const int stride, Vector2& left, Vector2& right, Color& color) {
+    const PointerSample& sample = TrailRibbonSample(k, count, stride);
+    const Vector2 before = TrailRibbonSample(std::max(k - 1, 0), count, stride).position;
+    const Vector2 after = TrailRibbonSample(std::min(k + 1, count - 1), count, stride).position;
+    const float length = V2Distance(before, after);
+    const Vector2 normal = length > 0.0f ? Vector2{-(after.y - before.y) / length, (after.x - before.x) / length} : Vector2{0, 0};
+
+    const float life = std::max(0.0f, 1.0f - static_cast<float>(harp.time - sample.time) / TRAIL_MAX_AGE);
+    const float half = TRAIL_WIDTH / 2 * life;
+    left = {sample.position.x - normal.x * half, sample.position.y - normal.y * half};
+    right = {sample.position.x + normal.x * half, sample.position.y + normal.y * half};
+    color = Fade(GREEN, TRAIL_ALPHA * life);
 }
 
+// The trail as one ribbon of quads in a single batch, with per-vertex alpha. At most TRAIL_RIBBON_POINTS points are
+// taken from the trail, so a fast flick costs the same as a slow one.
 void DrawTrail() {
-    if (cursorQueue.size() < 2) return; // Ensure at least two points exist
-
-    std::queue<Vector2> copyQueue(cursorQueue);
-    Vector2 prev = copyQueue.front(); // First point
-    copyQueue.pop();
-
-    int index = 0; // Track fade intensity
-
-    while (!copyQueue.empty()) {
-        Vector2 current = copyQueue.front();
-        copyQueue.pop();
-
-        // Draw interpolated circles between prev and current
-        float distance = V2Distance(prev, current);
-        int steps = (int)distance; // One circle per pixel distance
-
-        for (int j = 0; j <= steps; j++) {
-            const float t = (float)j / steps; // Interpolation factor
-            Vector2 interpolated = {
-                Lerp(prev.x, current.x, t),
-                Lerp(prev.y, current.y, t)
-            };
-
-            DrawCircle(interpolated.x, interpolated.y, std::min(index /4, 15), Fade(GREEN, index * 0.0001f));
-        }
-
-        prev = current; // Move to next segment
-        index++;
+    if (harp.cursorTrail.size() < 2) return; // Ensure at least two points exist
+
+    const int stride = (harp.cursorTrail.size() - 1) / (TRAIL_RIBBON_POINTS - 1) + 1;
+    const int count = (harp.cursorTrail.size() - 1) / stride + 1;
+
+    rlCheckRenderBatchLimit((count - 1) * 4);
+    rlSetTexture(0);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    Vector2 left0, right0;
+    Color color0;
+    TrailRibbonEdges(0, count, stride, left0, right0, color0);
+    for (int k = 1; k < count; ++k) {
+        Vector2 left1, right1;
+        Color color1;
+        TrailRibbonEdges(k, count, stride, left1, right1, color1);
+
+        rlColor4ub(color0.r, color0.g, color0.b, color0.a); rlVertex2f(left0.x, left0.y);
+        rlColor4ub(color0.r, color0.g, color0.b, color0.a); rlVertex2f(right0.x, right0.y);
+        rlColor4ub(color1.r, color1.g, color1.b, color1.a); rlVertex2f(right1.x, right1.y);
+        rlColor4ub(color1.r, color1.g, color1.b, color1.a); rlVertex2f(left1.x, left1.y);
+
+        left0 = left1;
+        right0 = right1;
+        color0 = color1;
     }
+    rlEnd();
+    CountDrawCalls(1);
 }
 
-void DrawUIBackground() {
+void DrawUIBackground(TextureCache& cache) {
     float color1 = 0.18f;
     float color2 = 0.20f;
-    Image grad = GenImageGradientLinear(screenWidth/2 - 300, screenHeight, 0, ColorFromNormalized({color1,color1,color1,1.0f}), ColorFromNormalized({color2,color2,color2,1.0f}));
-    Texture2D texture1 = LoadTextureFromImage(grad);
+    const Texture2D texture1 = GetCachedGradient(cache, screenWidth/2 - 300, screenHeight, 0, ColorFromNormalized({color1,color1,color1,1.0f}), ColorFromNormalized({color2,color2,color2,1.0f}));
     DrawTexture(texture1, 0,0, WHITE);
     // DrawRectangle(0,0,screenWidth/2 - 300, screenHeight, GRAY);
 }
 
-void runGameLoop() {
+// Progress bar drawn while the asset loader works through the startup assets
+void DrawLoadingScreen(const float progress) {
+    const int width = 400;
+    const int height = 12;
+    const int x = (screenWidth - width) / 2;
+    const int y = screenHeight / 2;
+    BeginDrawing();
+    ClearBackground(BLACK);
+    DrawText("Loading", x, y - 40, 20, LIGHTGRAY);
+    DrawRectangleLines(x, y, width, height, GRAY);
+    DrawRectangle(x, y, static_cast<int>(width * progress), height, LIGHTGRAY);
+    EndDrawing();
+}
+
+void runGameLoop(const LaunchOptions& options) {
+    const double startupBegin = GetTime();
+    JobSystem jobs(std::thread::hardware_concurrency());
+
+    // Decoding runs on the job system while the main thread sets up audio and the strings, then shows progress
+    AssetLoader loader(jobs);
+    const int stringAsset = loader.addTexture("stringtexturesmall2.png");
+    const int boltAsset = loader.addTexture("boltsmall3.png");
+    const int backgroundAsset = loader.addTexture("cedar_background3.png");
+    const int fretAsset = loader.addTexture("rosewood-texture-5.png");
+    const int gradientAsset = loader.addGeneratedTexture("string gradient", []() {
+        return GenImageGradientLinear(2, MAX_CORD_SIZE, 0,
+                                      ColorFromNormalized({0.9f,0.9f,0.9f,1.0f}),
+                                      ColorFromNormalized({0.4f,0.4f,0.4f,1.0f}));
+    });
+    const int roundedMaskAsset = loader.addFragmentShader("rounded_mask.fs");
+    const int blurAsset = loader.addFragmentShader("blur.fs");
+    loader.start();
+
+    double stageBegin = GetTime();
     InitAudioDevice();
-    addChords(CHORDS);
-    const Sound pluck = LoadSound("pluck1.wav");
-    // SetSoundVolume(pluck,0.15f);
-    const Texture2D textureString = LoadTexture("stringtexturesmall2.png");
-    const Texture2D textureBolt = LoadTexture("boltsmall3.png");
-    Texture2D background = LoadTexture("cedar_background3.png");
-    Texture2D fret = LoadTexture("rosewood-texture-5.png");
+    AudioSettings audioSettings;
+    audioSettings.bufferFrames = options.audioBufferFrames;
+    audioSettings.frameSeconds = 1.0 / TARGET_FPS;
+    if (!InitAudioEngine(audioSettings, CHORDS)) {
+        std::cerr << "Audio engine failed to start!" << std::endl;
+    }
+    const double audioMs = (GetTime() - stageBegin) * 1000.0;
+    stageBegin = GetTime();
+    addChords(harp, CHORDS);
+    const double chordsMs = (GetTime() - stageBegin) * 1000.0;
+
+    while (!loader.uploadReady()) {
+        if (WindowShouldClose()) {
+            // Closed during startup: nothing to save yet, just release what is already up and skip the game loop
+            loader.cancel();
+            ShutdownAudioEngine();
+            CloseAudioDevice();
+            CloseWindow();
+            return;
+        }
+        DrawLoadingScreen(loader.progress());
+    }
+
+    const Texture2D textureString = loader.texture(stringAsset);
+    const Texture2D textureBolt = loader.texture(boltAsset);
+    Texture2D background = loader.texture(backgroundAsset);
+    Texture2D fret = loader.texture(fretAsset);
+    const Texture2D gradTexture = loader.texture(gradientAsset);
     SetTextureFilter(fret, TEXTURE_FILTER_TRILINEAR);
 
-    Shader roundedMaskShader = LoadShader(0, "rounded_mask.fs");
+    Shader roundedMaskShader = loader.shader(roundedMaskAsset);
     if (!IsShaderValid(roundedMaskShader)) {
         std::cerr << "Shader failed to load!" << std::endl;
     }
+    Shader blurShader = loader.shader(blurAsset);
+    if (!IsShaderValid(blurShader)) {
+        std::cerr << "Blur shader failed to load!" << std::endl;
+    }
 
     background.height = screenHeight;
     background.width = screenWidth;
     fret.height = fret.height * 0.45;
     fret.width = fret.width * 0.45;
 
-    InitSound(pluck);
+    stageBegin = GetTime();
+    const RenderTexture2D shadow_strings = CreateShadowFromTexture(textureString, blurShader, textureString.width, textureString.height);
+    const RenderTexture2D shadow_bolts = CreateShadowFromTexture(textureBolt, blurShader, textureBolt.width * 4, textureBolt.height * 2);
+    const double shadowsMs = (GetTime() - stageBegin) * 1000.0;
+    // The string strips repeat the whole texture on every sample quad, like the per-sample sprites they replaced
+    SetTextureWrap(gradTexture, TEXTURE_WRAP_REPEAT);
+    SetTextureWrap(shadow_strings.texture, TEXTURE_WRAP_REPEAT);
+    TextureCache uiTextures;
+
+    // Startup timing report, by asset and by stage
+    std::cout << "Startup:" << std::endl;
+    loader.report(std::cout);
+    std::cout << "  audio engine " << audioMs << " ms, chords " << chordsMs << " ms, shadows " << shadowsMs
+              << " ms, first frame after " << (GetTime() - startupBegin) * 1000.0 << " ms" << std::endl;
+
+    bool showProfile = false;
+    const bool dumpingCsv = options.profileCsv != nullptr && OpenProfileCsv(options.profileCsv);
+    if (options.profileCsv != nullptr && !dumpingCsv) {
+        std::cerr << "Could not open profile output " << options.profileCsv << std::endl;
+    }
 
-    const Texture2D shadow_strings = CreateShadowFromTexture(textureString);
-    Texture2D shadow_bolts = CreateShadowFromTexture(textureBolt);
-    shadow_bolts = StretchTexture(shadow_bolts, 2.0f);
+    // A replay stands in for the mouse and the frame clock, and the window closes when it runs out
+    std::vector<HarpInput> replay;
+    const bool replaying = options.replayPath != nullptr && LoadInputRecording(options.replayPath, replay);
+    if (options.replayPath != nullptr && !replaying) {
+        std::cerr << "Could not load input recording " << options.replayPath << std::endl;
+    }
+    if (replaying && options.replayFast) SetTargetFPS(0);
+    std::vector<HarpInput> recording;
+    std::FILE* eventLog = options.eventLogPath != nullptr ? std::fopen(options.eventLogPath, "w") : nullptr;
+    if (options.eventLogPath != nullptr && eventLog == nullptr) {
+        std::cerr << "Could not open event log " << options.eventLogPath << std::endl;
+    }
+    long frame = 0;
 
-    const Image gradImg = GenImageGradientLinear(
-        2,
-        MAX_CORD_SIZE,
-        0,
-        ColorFromNormalized({0.9f,0.9f,0.9f,1.0f}),
-        ColorFromNormalized({0.4f,0.4f,0.4f,1.0f}));
-    const Texture2D gradTexture = LoadTextureFromImage(gradImg);
+    MidiFilePort midiFiles(options.midiOutPath, options.midiInPath);
+    if (!midiFiles.isOpen()) {
+        std::cerr << "Could not open MIDI files" << std::endl;
+    }
+    MidiBus midi;
+    if (options.midiOutPath != nullptr || options.midiInPath != nullptr) midi.port = &midiFiles;
 
-    // cursorQueue.push({0,0});
+    // harp.cursorTrail.push({{0,0}, 0.0});
 
-    while (!WindowShouldClose())    // Detect window close button or ESC key
+    while (!WindowShouldClose() && (!replaying || frame < static_cast<long>(replay.size())))    // Detect window close button or ESC key
     {
-        HandleSound();
-        // HandleCursor();
-        // HandleTrailCursor();
-        for (int i = 0; i < chords.size(); ++i) {
-            handleChordInteraction(chords.at(i), i);
+        BeginProfileFrame();
+        HarpInput input;
+        double inputClock;
+        {
+            ProfileScope scope(PROFILE_INPUT);
+            HandleSound();
+            HandleProfiler(showProfile, dumpingCsv);
+            input = replaying ? replay[frame] : ReadInput();
+            inputClock = GetAudioClock();
+            if (options.recordPath != nullptr) recording.push_back(input);
+        }
+        {
+            ProfileScope scope(PROFILE_UPDATE);
+            // HandleCursor(harp, input);
+            UpdateHarp(harp, input, &jobs);
+            ReceiveMidi(midi, harp, harp.time);
+        }
+        if (eventLog != nullptr) WritePluckLog(eventLog, frame, harp.plucks);
+        ++frame;
+        {
+            ProfileScope scope(PROFILE_AUDIO);
+            // harp.time is now the time of this frame's input, so the same shift puts every pluck of the frame, each at
+            // the point of the step where it crossed its string, on the audio clock
+            const double harpToAudio = inputClock - harp.time;
+            for (const PluckEvent& pluck : harp.plucks) {
+                QueueNoteOn(pluck.string, ScaleFrequency(pluck.string, BASE_FREQUENCY), pluck.velocity, pluck.position, pluck.time + harpToAudio);
+            }
+            PublishPlucks(midi, harp.plucks, harp.time);
+        }
+        {
+            ProfileScope scope(PROFILE_TESSELLATION);
+            // Tessellate every moved string before drawing starts, so drawChords only submits vertices
+            UpdateChordMeshes(harp, &jobs);
         }
 
         BeginDrawing();
-        ClearBackground(BLACK);
-        DrawTexture(background, 0, 0, WHITE);
-        // DrawUIBackground();
-        DrawTexture(fret, screenWidth/2 - fret.width/2, screenHeight/2 - fret.height/2, WHITE);
-        drawChords(gradTexture, textureBolt, shadow_strings, shadow_bolts);
-        DrawTrail();
+        {
+            ProfileScope scope(PROFILE_BACKGROUND);
+            ClearBackground(BLACK);
+            DrawTexture(background, 0, 0, WHITE);
+            // DrawUIBackground(uiTextures);
+            DrawTexture(fret, screenWidth/2 - fret.width/2, screenHeight/2 - fret.height/2, WHITE);
+            CountDrawCalls(2);
+        }
+        {
+            ProfileScope scope(PROFILE_DRAW_CHORDS);
+            drawChords(gradTexture, textureBolt, shadow_strings.texture, shadow_bolts.texture);
+        }
+        {
+            ProfileScope scope(PROFILE_DRAW_TRAIL);
+            if (harp.plectrum.shape == PLECTRUM_TRAIL) DrawTrail();
+        }
         // DrawCursor();
         // DrawBow();
         // DrawTrailCursor();
-        EndDrawing();
+        if (showProfile) DrawProfileOverlay(20, 20);
+        {
+            ProfileScope scope(PROFILE_PRESENT);
+            EndDrawing();
+        }
+    }
+    FlushMidiNotes(midi, harp.time);
+    CloseProfileCsv();
+    if (eventLog != nullptr) std::fclose(eventLog);
+    if (options.recordPath != nullptr && !SaveInputRecording(options.recordPath, recording)) {
+        std::cerr << "Could not save input recording " << options.recordPath << std::endl;
     }
     UnloadTexture(textureString);
     UnloadTexture(textureBolt);
     UnloadTexture(background);
     UnloadTexture(fret);
-    UnloadTexture(shadow_strings);
+    UnloadRenderTexture(shadow_strings);
     UnloadTexture(gradTexture);
-    UnloadTexture(shadow_bolts);
-    UnloadImage(gradImg);
-    UnloadSound(pluck);
+    UnloadRenderTexture(shadow_bolts);
+    UnloadTextureCache(uiTextures);
+    ShutdownAudioEngine();
 
     UnloadShader(roundedMaskShader);
+    UnloadShader(blurShader);
     CloseAudioDevice();
     CloseWindow();
 }
 
 
-int main() {
+// Frames for --audio-buffer, clamped to what the audio callback can sustain. Falls back to the default on anything
+// that is not a number.
+int ParseAudioBufferFrames(const char* value) {
+    char* end = nullptr;
+    const long frames = std::strtol(value, &end, 10);
+    if (end == value || *end != '\0') {
+        std::cerr << "--audio-buffer: '" << value << "' is not a number, using " << AUDIO_BUFFER_FRAMES << std::endl;
+        return AUDIO_BUFFER_FRAMES;
+    }
+    const long clamped = std::min(std::max(frames, static_cast<long>(MIN_AUDIO_BUFFER_FRAMES)),
+                                  static_cast<long>(MAX_AUDIO_BUFFER_FRAMES));
+    if (clamped != frames) {
+        std::cerr << "--audio-buffer: " << value << " is outside " << MIN_AUDIO_BUFFER_FRAMES << ".."
+                  << MAX_AUDIO_BUFFER_FRAMES << ", using " << clamped << std::endl;
+    }
+    return static_cast<int>(clamped);
+}
+
+// --profile-csv <file>   per-frame stage timings from the first frame on, for comparing builds offline
+// --record <file>        saves every frame's input on exit, see input_recording.h
+// --replay <file>        plays a recording back instead of the mouse, at its original frame rate
+// --replay-fast          with --replay: no frame cap, as fast as the machine renders
+// --event-log <file>     one line per pluck, to diff two runs of the same recording
+// --midi-out <file>      plucks as MIDI note-on/note-off records, see MidiFilePort
+// --midi-in <file>       MIDI records that pluck the strings they play, at their recorded times
+// --audio-buffer <n>     audio stream buffer in frames, 32..8192, 256 by default; smaller is lower latency and more
+//                        callbacks
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--replay-fast") == 0) options.replayFast = true;
+        else if (hasValue && std::strcmp(argv[i], "--profile-csv") == 0) options.profileCsv = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--record") == 0) options.recordPath = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--replay") == 0) options.replayPath = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--event-log") == 0) options.eventLogPath = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--midi-out") == 0) options.midiOutPath = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--midi-in") == 0) options.midiInPath = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--audio-buffer") == 0) options.audioBufferFrames = ParseAudioBufferFrames(argv[++i]);
+    }
+
     ConfigFlags flags = FLAG_MSAA_4X_HINT;
     SetConfigFlags(flags);
     InitWindow(screenWidth, screenHeight, "DigiHarp");
-    SetTargetFPS(60);
+    SetTargetFPS(TARGET_FPS);
     print(GetWorkingDirectory(), "dir");
-    runGameLoop();
+    runGameLoop(options);
     return 0;
 }
 
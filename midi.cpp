@@ -0,0 +1,116 @@
+#include "midi.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    const int MAJOR_STEPS[7] = {0, 2, 4, 5, 7, 9, 11};
+    constexpr size_t MIDI_RECORD_SIZE = sizeof(double) + 3;
+
+    void SendNote(MidiBus& bus, const int type, const int note, const int velocity, const double time) {
+        bus.port->send({time, static_cast<unsigned char>(type | (bus.channel & 0x0F)),
+                        static_cast<unsigned char>(note), static_cast<unsigned char>(velocity)});
+    }
+
+    void SendDueNoteOffs(MidiBus& bus, const double now) {
+        for (int note = 0; note < static_cast<int>(bus.noteOffTime.size()); ++note) {
+            if (bus.noteOffTime[note] >= 0.0 && bus.noteOffTime[note] <= now) {
+                SendNote(bus, MIDI_NOTE_OFF, note, 0, bus.noteOffTime[note]);
+                bus.noteOffTime[note] = -1.0;
+            }
+        }
+    }
+}
+
+MidiFilePort::MidiFilePort(const char* outputPath, const char* inputPath) {
+    if (outputPath != nullptr) {
+        output_ = std::fopen(outputPath, "wb");
+        failed_ |= output_ == nullptr;
+    }
+    if (inputPath != nullptr) {
+        input_ = std::fopen(inputPath, "rb");
+        failed_ |= input_ == nullptr;
+    }
+}
+
+MidiFilePort::~MidiFilePort() {
+    if (output_ != nullptr) std::fclose(output_);
+    if (input_ != nullptr) std::fclose(input_);
+}
+
+bool MidiFilePort::isOpen() const {
+    return !failed_;
+}
+
+bool MidiFilePort::send(const MidiMessage& message) {
+    if (output_ == nullptr) return false;
+    unsigned char record[MIDI_RECORD_SIZE];
+    std::memcpy(record, &message.time, sizeof(double));
+    record[sizeof(double)] = message.status;
+    record[sizeof(double) + 1] = message.data1;
+    record[sizeof(double) + 2] = message.data2;
+    return std::fwrite(record, sizeof(record), 1, output_) == 1;
+}
+
+bool MidiFilePort::receive(MidiMessage& message) {
+    unsigned char record[MIDI_RECORD_SIZE];
+    if (input_ == nullptr || std::fread(record, sizeof(record), 1, input_) != 1) return false;
+    std::memcpy(&message.time, record, sizeof(double));
+    message.status = record[sizeof(double)];
+    message.data1 = record[sizeof(double) + 1];
+    message.data2 = record[sizeof(double) + 2];
+    return true;
+}
+
+int StringMidiNote(const int string) {
+    const int octave = string >= 0 ? string / 7 : (string - 6) / 7;
+    return MIDI_BASE_NOTE + octave * 12 + MAJOR_STEPS[string - octave * 7];
+}
+
+int MidiNoteString(const int note, const int count) {
+    const int semitones = note - MIDI_BASE_NOTE;
+    const int octave = semitones >= 0 ? semitones / 12 : (semitones - 11) / 12;
+    const int* step = std::find(MAJOR_STEPS, MAJOR_STEPS + 7, semitones - octave * 12);
+    if (step == MAJOR_STEPS + 7) return -1;
+    const int string = octave * 7 + static_cast<int>(step - MAJOR_STEPS);
+    return string >= 0 && string < count ? string : -1;
+}
+
+void PublishPlucks(MidiBus& bus, const std::vector<PluckEvent>& plucks, const double now) {
+    if (bus.port == nullptr) return;
+    SendDueNoteOffs(bus, now);
+    for (const PluckEvent& pluck : plucks) {
+        if (pluck.source != PLUCK_PLECTRUM) continue;
+        const int note = StringMidiNote(pluck.string);
+        if (note < 0 || note > 127) continue;
+        if (bus.noteOffTime[note] >= 0.0) SendNote(bus, MIDI_NOTE_OFF, note, 0, pluck.time);
+        const int velocity = std::min(127, std::max(1, static_cast<int>(std::lround(pluck.velocity * 127.0f))));
+        SendNote(bus, MIDI_NOTE_ON, note, velocity, pluck.time);
+        bus.noteOffTime[note] = pluck.time + MIDI_NOTE_SECONDS;
+    }
+}
+
+void ReceiveMidi(MidiBus& bus, Harp& harp, const double now) {
+    if (bus.port == nullptr) return;
+    while (bus.hasPending || bus.port->receive(bus.pending)) {
+        bus.hasPending = true;
+        if (bus.pending.time > now) return;     // keep it for the frame it belongs to
+        bus.hasPending = false;
+
+        const MidiMessage& message = bus.pending;
+        if ((message.status & 0xF0) != MIDI_NOTE_ON || message.data2 == 0) continue;   // velocity 0 is a note-off
+        const int string = MidiNoteString(message.data1, harp.chords.count);
+        if (string < 0) continue;
+        PluckChord(harp, string, message.data2 / 127.0f, std::min(message.time, harp.time), PLUCK_EXTERNAL);
+    }
+}
+
+void FlushMidiNotes(MidiBus& bus, const double now) {
+    if (bus.port == nullptr) return;
+    for (int note = 0; note < static_cast<int>(bus.noteOffTime.size()); ++note) {
+        if (bus.noteOffTime[note] >= 0.0) {
+            SendNote(bus, MIDI_NOTE_OFF, note, 0, now);
+            bus.noteOffTime[note] = -1.0;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef MIDI_H
+#define MIDI_H
+
+// MIDI view of the pluck event stream. Plucks go out as note-on/note-off messages, incoming note-ons pluck the
+// matching string through PluckChord. Transport is a MidiPort, so the bus can run against a loopback queue, a file
+// or, later, a platform MIDI device without changing. Publishing and receiving never allocate.
+#include "harp.h"
+#include "spsc_queue.h"
+#include <array>
+#include <cstdio>
+#include <vector>
+
+constexpr int MIDI_NOTE_ON = 0x90;
+constexpr int MIDI_NOTE_OFF = 0x80;
+constexpr int MIDI_BASE_NOTE = 48;              // C3, the pitch of string 0 (BASE_FREQUENCY)
+constexpr float MIDI_NOTE_SECONDS = 2.0f;       // a pluck's note-off, unless the string is plucked again first
+
+struct MidiMessage {
+    double time;                                // Harp::time it belongs to
+    unsigned char status;                       // message type in the high nibble, channel in the low one
+    unsigned char data1;                        // note
+    unsigned char data2;                        // velocity
+};
+
+class MidiPort {
+public:
+    virtual ~MidiPort() {}
+    virtual bool send(const MidiMessage& message) = 0;
+    // Next incoming message, in time order; false when there is none waiting
+    virtual bool receive(MidiMessage& message) = 0;
+};
+
+// What goes in comes back out, across threads if need be (one sender, one receiver). For tests and benchmarks.
+class MidiLoopbackPort : public MidiPort {
+public:
+    bool send(const MidiMessage& message) override { return queue_.push(message); }
+    bool receive(MidiMessage& message) override { return queue_.pop(message); }
+
+private:
+    SpscQueue<MidiMessage, 1024> queue_;
+};
+
+// File stand-in for a MIDI device: sent messages are appended to one file, received ones read from another, as
+// records of a float64 time and the three message bytes. Either path may be null.
+class MidiFilePort : public MidiPort {
+public:
+    MidiFilePort(const char* outputPath, const char* inputPath);
+    ~MidiFilePort() override;
+
+    MidiFilePort(const MidiFilePort&) = delete;
+    MidiFilePort& operator=(const MidiFilePort&) = delete;
+
+    bool isOpen() const;
+    bool send(const MidiMessage& message) override;
+    bool receive(MidiMessage& message) override;
+
+private:
+    std::FILE* output_ = nullptr;
+    std::FILE* input_ = nullptr;
+    bool failed_ = false;                       // a path was given and could not be opened
+};
+
+struct MidiBus {
+    MidiPort* port = nullptr;
+    int channel = 0;
+    std::array<double, 128> noteOffTime;        // per note, when its note-off is due; negative while silent
+    MidiMessage pending;                        // incoming message read ahead of its time
+    bool hasPending = false;
+
+    MidiBus() { noteOffTime.fill(-1.0); }
+};
+
+// MIDI note of a string, strings going up the major scale from MIDI_BASE_NOTE like the audio engine's pitches.
+int StringMidiNote(int string);
+// String playing a MIDI note, or -1 if the note is off the scale or past the last of count strings
+int MidiNoteString(int note, int count);
+
+// Sends the note-offs due by now, then a note-on (preceded by a note-off if the note still sounds) for every
+// plectrum pluck. External plucks are not sent back out, so a loopback does not feed on itself.
+void PublishPlucks(MidiBus& bus, const std::vector<PluckEvent>& plucks, double now);
+// Plucks the string of every incoming note-on due by now, at the note's own time. Call after UpdateHarp, like
+// PluckChord.
+void ReceiveMidi(MidiBus& bus, Harp& harp, double now);
+// Note-off for everything still sounding
+void FlushMidiNotes(MidiBus& bus, double now);
+
+#endif //MIDI_H
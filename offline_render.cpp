@@ -0,0 +1,158 @@
+#include "offline_render.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    constexpr int PRE_ROLL_CHUNK = 4096;    // frames of scratch for rendering up to a block's first sample
+
+    struct Note {
+        long frame;
+        int string;
+        float frequency;
+        float velocity;
+        float position;
+        uint32_t seed;                      // noise for the pluck shape, fixed per note so any block can replay it
+    };
+
+    // Advances the bank from frame cursor to target. Frames before first are only needed for the strings' state
+    // and go to scratch; the rest is mixed into out, which starts at first.
+    void RenderUntil(StringBank& bank, long& cursor, const long target, const long first, float* out, float* scratch) {
+        while (cursor < first && cursor < target) {
+            const int n = static_cast<int>(std::min<long>(std::min(target, first) - cursor, PRE_ROLL_CHUNK));
+            std::fill(scratch, scratch + n, 0.0f);
+            RenderStringBank(bank, scratch, n);
+            cursor += n;
+        }
+        if (cursor < target) {
+            RenderStringBank(bank, out + (cursor - first), static_cast<int>(target - cursor));
+            cursor = target;
+        }
+    }
+
+    // Renders frames [first, first + frames) into out. Each string only depends on its last pluck before first, so
+    // rendering starts at the oldest of those, skipping strings that were last plucked more than tail ago.
+    void RenderBlock(const std::vector<Note>& notes, const OfflineRenderSettings& settings, const long tail,
+                     const long first, const int frames, float* out) {
+        std::fill(out, out + frames, 0.0f);
+        const auto firstNote = std::lower_bound(notes.begin(), notes.end(), first,
+                                                [](const Note& note, const long frame) { return note.frame < frame; });
+        long start = first;
+        std::vector<unsigned char> seen(settings.strings, 0);
+        int unseen = settings.strings;
+        for (auto note = firstNote; note != notes.begin() && unseen > 0;) {
+            --note;
+            if (note->frame < first - tail) break;
+            if (!seen[note->string]) {
+                seen[note->string] = 1;
+                --unseen;
+                start = note->frame;
+            }
+        }
+
+        StringBank bank;
+        InitStringBank(bank, settings.strings);
+        float scratch[PRE_ROLL_CHUNK];
+        long cursor = start;
+        const long end = first + frames;
+        auto note = std::lower_bound(notes.begin(), notes.end(), start,
+                                     [](const Note& n, const long frame) { return n.frame < frame; });
+        for (; note != notes.end() && note->frame < end; ++note) {
+            RenderUntil(bank, cursor, note->frame, first, out, scratch);
+            uint32_t seed = note->seed;
+            ExciteString(bank, note->string, settings.sampleRate, note->frequency, note->velocity, note->position, seed);
+        }
+        RenderUntil(bank, cursor, end, first, out, scratch);
+
+        for (int i = 0; i < frames; ++i) {
+            out[i] *= MASTER_GAIN;
+        }
+    }
+
+    void WriteLE(std::FILE* file, const uint32_t value, const int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            std::fputc((value >> (8 * i)) & 0xFF, file);
+        }
+    }
+
+    void WriteWavHeader(std::FILE* file, const int sampleRate, const long frames) {
+        const uint32_t dataBytes = static_cast<uint32_t>(frames * 2);
+        std::fwrite("RIFF", 1, 4, file);
+        WriteLE(file, 36 + dataBytes, 4);
+        std::fwrite("WAVEfmt ", 1, 8, file);
+        WriteLE(file, 16, 4);                   // fmt chunk size
+        WriteLE(file, 1, 2);                    // PCM
+        WriteLE(file, 1, 2);                    // mono
+        WriteLE(file, sampleRate, 4);
+        WriteLE(file, sampleRate * 2, 4);       // bytes per second
+        WriteLE(file, 2, 2);                    // bytes per frame
+        WriteLE(file, 16, 2);                   // bits per sample
+        std::fwrite("data", 1, 4, file);
+        WriteLE(file, dataBytes, 4);
+    }
+
+    void WritePcm16(std::FILE* file, const float* samples, const int frames, std::vector<unsigned char>& bytes) {
+        bytes.resize(frames * 2);
+        for (int i = 0; i < frames; ++i) {
+            const float clamped = std::min(std::max(samples[i], -1.0f), 1.0f);
+            const int16_t value = static_cast<int16_t>(std::lrint(clamped * 32767.0f));
+            bytes[2 * i] = static_cast<unsigned char>(value & 0xFF);
+            bytes[2 * i + 1] = static_cast<unsigned char>((value >> 8) & 0xFF);
+        }
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+    }
+}
+
+bool RenderPlucksToWav(const char* path, std::vector<PluckEvent> plucks, const OfflineRenderSettings& settings,
+                       JobSystem* jobs) {
+    std::sort(plucks.begin(), plucks.end(), [](const PluckEvent& a, const PluckEvent& b) { return a.time < b.time; });
+
+    std::vector<Note> notes;
+    notes.reserve(plucks.size());
+    for (const PluckEvent& pluck : plucks) {
+        if (pluck.string < 0 || pluck.string >= settings.strings || pluck.time < 0.0) continue;
+        const uint32_t seed = 22222u + 2654435761u * static_cast<uint32_t>(notes.size());
+        notes.push_back({std::lround(pluck.time * settings.sampleRate), pluck.string,
+                         ScaleFrequency(pluck.string, settings.baseFrequency), pluck.velocity, pluck.position, seed});
+    }
+
+    const long tail = std::lround(settings.tailSeconds * settings.sampleRate);
+    const long total = notes.empty() ? 0 : notes.back().frame + tail;
+    const int blockFrames = static_cast<int>(std::max(1.0, std::min<double>(settings.blockSeconds * settings.sampleRate,
+                                                                              std::max(total, 1L))));
+    const long blocks = (total + blockFrames - 1) / blockFrames;
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    WriteWavHeader(file, settings.sampleRate, total);
+
+    // One block per thread at a time, written in order once the whole batch is done
+    const int batch = jobs != nullptr ? jobs->threadCount() : 1;
+    std::vector<float> buffers(static_cast<size_t>(batch) * blockFrames);
+    std::vector<unsigned char> bytes;
+    for (long firstBlock = 0; firstBlock < blocks; firstBlock += batch) {
+        const int count = static_cast<int>(std::min<long>(batch, blocks - firstBlock));
+        const auto renderBlocks = [&](const int begin, const int end) {
+            for (int b = begin; b < end; ++b) {
+                const long first = (firstBlock + b) * blockFrames;
+                const int frames = static_cast<int>(std::min<long>(blockFrames, total - first));
+                RenderBlock(notes, settings, tail, first, frames, &buffers[static_cast<size_t>(b) * blockFrames]);
+            }
+        };
+        if (jobs != nullptr) {
+            jobs->parallelFor(count, 1, renderBlocks);
+        } else {
+            renderBlocks(0, count);
+        }
+
+        for (int b = 0; b < count; ++b) {
+            const long first = (firstBlock + b) * blockFrames;
+            const int frames = static_cast<int>(std::min<long>(blockFrames, total - first));
+            WritePcm16(file, &buffers[static_cast<size_t>(b) * blockFrames], frames, bytes);
+        }
+    }
+    const bool ok = !std::ferror(file);
+    return std::fclose(file) == 0 && ok;
+}
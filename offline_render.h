@@ -0,0 +1,28 @@
+#ifndef OFFLINE_RENDER_H
+#define OFFLINE_RENDER_H
+
+// Bounces a performance to a WAV file without an audio device, using the same Karplus-Strong strings, pitch
+// mapping and mix gain as the live audio engine.
+#include "harp.h"
+#include "karplus_strong.h"
+#include <vector>
+
+class JobSystem;
+
+struct OfflineRenderSettings {
+    int sampleRate = 48000;
+    int strings = CHORDS;
+    float baseFrequency = BASE_FREQUENCY;
+    float blockSeconds = 20.0f;     // length of the independently rendered time blocks
+    float tailSeconds = 6.0f;       // how long a pluck is rendered before it counts as silent, about -100 dB
+};
+
+// Renders plucks (any order; time in seconds from the start of the file) to a 16-bit mono WAV at path. The output
+// is cut into blocks of blockSeconds that are rendered in parallel on jobs, if given, and written out in order,
+// so memory stays at one block per thread however long the performance is. A block starts from silence a little
+// before its first sample: every string is replayed from its last pluck before the block, which replaces whatever
+// it sounded before, so blocks join seamlessly. Returns false if the file could not be written.
+bool RenderPlucksToWav(const char* path, std::vector<PluckEvent> plucks, const OfflineRenderSettings& settings,
+                       JobSystem* jobs = nullptr);
+
+#endif //OFFLINE_RENDER_H
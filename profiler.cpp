@@ -0,0 +1,132 @@
+#include "profiler.h"
+#include "raylib.h"
+#include "ring_buffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    struct FrameProfile {
+        float stageMs[PROFILE_STAGE_COUNT];
+        float frameMs;              // whole loop iteration, including anything outside the stages
+        int drawCalls;
+    };
+
+    const char* const STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+        "input", "update", "audio", "tessellation", "background", "draw_chords", "draw_trail", "present"
+    };
+
+    constexpr int OVERLAY_FONT_SIZE = 16;
+    constexpr int OVERLAY_LINE = OVERLAY_FONT_SIZE + 4;
+
+    bool enabled = false;
+    std::FILE* csv = nullptr;
+    long frameIndex = 0;
+    double frameStart = -1.0;
+    FrameProfile current = {};
+    RingBuffer<FrameProfile, PROFILE_HISTORY> history;
+
+    double ProfileClock() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void WriteCsvRow(const FrameProfile& frame) {
+        std::fprintf(csv, "%ld", frameIndex);
+        for (int s = 0; s < PROFILE_STAGE_COUNT; ++s) {
+            std::fprintf(csv, ",%.4f", frame.stageMs[s]);
+        }
+        std::fprintf(csv, ",%.4f,%d\n", frame.frameMs, frame.drawCalls);
+    }
+
+    struct StageStats {
+        float p50;
+        float p99;
+        float max;
+    };
+
+    template <typename Get>
+    StageStats ComputeStats(Get get) {
+        float values[PROFILE_HISTORY];
+        const int count = history.size();
+        for (int i = 0; i < count; ++i) {
+            values[i] = get(history[i]);
+        }
+        std::sort(values, values + count);
+        return {values[count / 2], values[std::min(count - 1, count * 99 / 100)], values[count - 1]};
+    }
+}
+
+void SetProfiling(const bool on) {
+    if (on != enabled) {
+        history.clear();
+        frameStart = -1.0;
+    }
+    enabled = on;
+}
+
+bool IsProfilingEnabled() {
+    return enabled;
+}
+
+bool OpenProfileCsv(const char* path) {
+    CloseProfileCsv();
+    csv = std::fopen(path, "w");
+    if (csv == nullptr) return false;
+
+    std::fprintf(csv, "frame");
+    for (int s = 0; s < PROFILE_STAGE_COUNT; ++s) {
+        std::fprintf(csv, ",%s_ms", STAGE_NAMES[s]);
+    }
+    std::fprintf(csv, ",frame_ms,draw_calls\n");
+    SetProfiling(true);
+    return true;
+}
+
+void CloseProfileCsv() {
+    if (csv == nullptr) return;
+    std::fclose(csv);
+    csv = nullptr;
+}
+
+void BeginProfileFrame() {
+    if (!enabled) return;
+    const double now = ProfileClock();
+    if (frameStart >= 0.0) {
+        current.frameMs = static_cast<float>((now - frameStart) * 1000.0);
+        history.push(current);
+        if (csv != nullptr) WriteCsvRow(current);
+        ++frameIndex;
+    }
+    frameStart = now;
+    current = {};
+}
+
+void CountDrawCalls(const int count) {
+    if (enabled) current.drawCalls += count;
+}
+
+void DrawProfileOverlay(const int x, const int y) {
+    if (!enabled || history.empty()) return;
+
+    const int lines = PROFILE_STAGE_COUNT + 3;
+    DrawRectangle(x - 8, y - 8, 360, lines * OVERLAY_LINE + 12, Fade(BLACK, 0.7f));
+    DrawText("stage            p50     p99     max  (ms)", x, y, OVERLAY_FONT_SIZE, WHITE);
+    for (int s = 0; s < PROFILE_STAGE_COUNT; ++s) {
+        const StageStats stats = ComputeStats([s](const FrameProfile& frame) { return frame.stageMs[s]; });
+        DrawText(TextFormat("%-14s %7.3f %7.3f %7.3f", STAGE_NAMES[s], stats.p50, stats.p99, stats.max),
+                 x, y + (s + 1) * OVERLAY_LINE, OVERLAY_FONT_SIZE, WHITE);
+    }
+    const StageStats frame = ComputeStats([](const FrameProfile& f) { return f.frameMs; });
+    DrawText(TextFormat("%-14s %7.3f %7.3f %7.3f", "frame", frame.p50, frame.p99, frame.max),
+             x, y + (PROFILE_STAGE_COUNT + 1) * OVERLAY_LINE, OVERLAY_FONT_SIZE, YELLOW);
+    DrawText(TextFormat("draw calls %d, %d frames", history.back().drawCalls, (int)history.size()),
+             x, y + (PROFILE_STAGE_COUNT + 2) * OVERLAY_LINE, OVERLAY_FONT_SIZE, WHITE);
+}
+
+ProfileScope::ProfileScope(const ProfileStage stage) : stage_(stage), start_(enabled ? ProfileClock() : -1.0) {
+}
+
+ProfileScope::~ProfileScope() {
+    if (start_ < 0.0 || !enabled) return;
+    current.stageMs[stage_] += static_cast<float>((ProfileClock() - start_) * 1000.0);
+}
@@ -0,0 +1,54 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Stages of one pass through the game loop, in the order they run
+enum ProfileStage {
+    PROFILE_INPUT,          // keyboard shortcuts, pointer read
+    PROFILE_UPDATE,         // UpdateHarp: plectrum interaction and string physics
+    PROFILE_AUDIO,          // forwarding plucks to the audio engine
+    PROFILE_TESSELLATION,   // UpdateChordMeshes
+    PROFILE_BACKGROUND,     // clear, background and fret board
+    PROFILE_DRAW_CHORDS,
+    PROFILE_DRAW_TRAIL,
+    PROFILE_PRESENT,        // EndDrawing: flushing the batch to the GPU, swap and vsync wait
+    PROFILE_STAGE_COUNT
+};
+
+constexpr int PROFILE_HISTORY = 512;   // frames kept for the overlay statistics, power of two
+
+// Per-stage frame timing. Every stage is wrapped in a ProfileScope; the timings of a frame are collected from one
+// BeginProfileFrame to the next and kept for the last PROFILE_HISTORY frames. The draw stages measure CPU
+// submission only, the GPU work itself shows up in PROFILE_PRESENT. While profiling is off a scope costs one branch
+// and nothing is recorded.
+void SetProfiling(bool enabled);
+bool IsProfilingEnabled();
+
+// Writes one CSV row per frame to path, for offline analysis; turns profiling on. Returns false if the file
+// could not be opened.
+bool OpenProfileCsv(const char* path);
+void CloseProfileCsv();
+
+// Called once at the top of the loop: closes the previous frame, measuring it up to this point, and starts the next
+void BeginProfileFrame();
+
+// Adds count draw submissions (texture draws and batched strips) to the current frame
+void CountDrawCalls(int count);
+
+// p50/p99/max of every stage and of the whole frame over the history, plus draw submissions of the last frame.
+// Called between BeginDrawing and EndDrawing.
+void DrawProfileOverlay(int x, int y);
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage stage);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileStage stage_;
+    double start_;          // negative while profiling is off
+};
+
+#endif //PROFILER_H
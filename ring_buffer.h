@@ -0,0 +1,42 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <array>
+#include <cstddef>
+
+// Fixed-capacity FIFO that never allocates. Pushing onto a full buffer drops the oldest item, which is what a
+// history like the cursor trail wants. Items are indexed oldest first, buffer[0] is front() and
+// buffer[size() - 1] is back(). Single-threaded; see SpscQueue for the cross-thread version. Capacity must be a
+// power of two.
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+public:
+    void push(const T& item) {
+        if (size() == Capacity) ++head_;
+        items_[tail_++ & (Capacity - 1)] = item;
+    }
+
+    void pop_front() { ++head_; }
+    void pop_front(const size_t count) { head_ += count < size() ? count : size(); }
+    void clear() { head_ = tail_; }
+
+    T& front() { return items_[head_ & (Capacity - 1)]; }
+    const T& front() const { return items_[head_ & (Capacity - 1)]; }
+    T& back() { return items_[(tail_ - 1) & (Capacity - 1)]; }
+    const T& back() const { return items_[(tail_ - 1) & (Capacity - 1)]; }
+    T& operator[](const size_t i) { return items_[(head_ + i) & (Capacity - 1)]; }
+    const T& operator[](const size_t i) const { return items_[(head_ + i) & (Capacity - 1)]; }
+
+    size_t size() const { return tail_ - head_; }
+    bool empty() const { return head_ == tail_; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> items_;
+    size_t head_ = 0;               // running counts, wrapped on access
+    size_t tail_ = 0;
+};
+
+#endif //RING_BUFFER_H
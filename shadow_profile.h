@@ -0,0 +1,50 @@
+#ifndef SHADOW_PROFILE_H
+#define SHADOW_PROFILE_H
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+inline float ParabolaSecondPhase(const int x, const float max_input, const float max_output) {
+    const auto flx = static_cast<float>(x);
+    const float z = 0.225f * max_input * (0.01818f * max_output * -1.0f + 1.3636f);
+    const float func = -1.0f * std::pow(flx/z,2.0f) + max_output;
+    if (func > 0) return func;
+    return 0;
+}
+
+// Drop-shadow offset for every sample of a string, in the order the spline is sampled: the first segment runs the
+// parabola backwards towards the middle of the string, the second runs it forwards again. Depends only on the
+// number of samples per segment, so it is built once per chord and indexed per frame.
+inline void BuildShadowProfile(std::vector<float>& profile, const int textureSegments, const float maxOutput) {
+    const int numSegments = 2;
+    profile.resize(numSegments * textureSegments);
+    for (int k = 0; k < numSegments * textureSegments; ++k) {
+        const int j = k % textureSegments;
+        const int x = k < textureSegments ? textureSegments - j : j;
+        profile[k] = ParabolaSecondPhase(x, textureSegments, maxOutput);
+    }
+}
+
+// InverseParabola is only positive for x in [0, 40], so those values are tabulated once and everything else is 0.
+constexpr int INVERSE_PARABOLA_RANGE = 41;
+
+struct InverseParabolaTable {
+    std::array<float, INVERSE_PARABOLA_RANGE> values;
+
+    InverseParabolaTable() {
+        for (int x = 0; x < INVERSE_PARABOLA_RANGE; ++x) {
+            const auto flx = static_cast<float>(x);
+            const float func = -1.0f * std::pow((flx-20.0f)/4.5f, 2.0f) + 20.0f;
+            values[x] = func > 0 ? func : 0;
+        }
+    }
+};
+
+inline float InverseParabola(const int x) {
+    static const InverseParabolaTable table;
+    if (x < 0 || x >= INVERSE_PARABOLA_RANGE) return 0;
+    return table.values[x];
+}
+
+#endif //SHADOW_PROFILE_H
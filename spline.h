@@ -0,0 +1,49 @@
+#ifndef SPLINE_H
+#define SPLINE_H
+
+#include "raylib.h"
+#include <cmath>
+
+// One Catmull-Rom segment in power form, P(t) = a*t^3 + b*t^2 + c*t + d, for t in [0, 1] between p2 and p3.
+// Same curve as raylib's GetSplinePointCatmullRom, but the coefficients are worked out once per segment so each
+// sample is a Horner evaluation, and the tangent comes from the closed-form derivative instead of a second
+// spline evaluation.
+struct CatmullRomSegment {
+    Vector2 a;
+    Vector2 b;
+    Vector2 c;
+    Vector2 d;
+};
+
+inline CatmullRomSegment MakeCatmullRomSegment(const Vector2 p1, const Vector2 p2, const Vector2 p3, const Vector2 p4) {
+    CatmullRomSegment seg;
+    seg.a = {0.5f * (-p1.x + 3.0f*p2.x - 3.0f*p3.x + p4.x), 0.5f * (-p1.y + 3.0f*p2.y - 3.0f*p3.y + p4.y)};
+    seg.b = {0.5f * (2.0f*p1.x - 5.0f*p2.x + 4.0f*p3.x - p4.x), 0.5f * (2.0f*p1.y - 5.0f*p2.y + 4.0f*p3.y - p4.y)};
+    seg.c = {0.5f * (p3.x - p1.x), 0.5f * (p3.y - p1.y)};
+    seg.d = p2;
+    return seg;
+}
+
+inline Vector2 CatmullRomPoint(const CatmullRomSegment& seg, const float t) {
+    return {
+        ((seg.a.x*t + seg.b.x)*t + seg.c.x)*t + seg.d.x,
+        ((seg.a.y*t + seg.b.y)*t + seg.c.y)*t + seg.d.y
+    };
+}
+
+// Position and unit tangent in one pass. A degenerate (zero-length) derivative falls back to +x, which is the
+// direction of a string at rest.
+inline void CatmullRomPointTangent(const CatmullRomSegment& seg, const float t, Vector2& point, Vector2& tangent) {
+    point = CatmullRomPoint(seg, t);
+
+    const float dx = (3.0f*seg.a.x*t + 2.0f*seg.b.x)*t + seg.c.x;
+    const float dy = (3.0f*seg.a.y*t + 2.0f*seg.b.y)*t + seg.c.y;
+    const float len = sqrtf(dx*dx + dy*dy);
+    if (len > 1e-6f) {
+        tangent = {dx / len, dy / len};
+    } else {
+        tangent = {1.0f, 0.0f};
+    }
+}
+
+#endif //SPLINE_H
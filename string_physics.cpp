@@ -0,0 +1,94 @@
+#include "string_physics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float FUNDAMENTAL_DECAY = 5.0f;   // 1/s, the fundamental loses 99% in about a second
+    constexpr float SETTLED = 0.05f;            // px, and px per step, below which a string counts as still
+    constexpr float PI = 3.14159265358979f;
+}
+
+void InitStringModes(StringModes& modes, const std::vector<float>& fundamentals) {
+    const int count = fundamentals.size();
+    const int size = count * STRING_MODES;
+    modes.count = count;
+    modes.amplitude.assign(size, 0.0f);
+    modes.velocity.assign(size, 0.0f);
+    modes.omegaSquared.resize(size);
+    modes.damping.resize(size);
+    modes.shape.assign(size, 0.0f);
+    modes.position.assign(count, 0.5f);
+    modes.previous.assign(count, 0.0f);
+    modes.current.assign(count, 0.0f);
+    modes.held.assign(count, 0);
+    modes.moving.assign(count, 0);
+
+    for (int s = 0; s < count; ++s) {
+        for (int n = 0; n < STRING_MODES; ++n) {
+            const float omega = 2.0f * PI * fundamentals[s] * (n + 1);
+            modes.omegaSquared[s * STRING_MODES + n] = omega * omega;
+            modes.damping[s * STRING_MODES + n] = 2.0f * FUNDAMENTAL_DECAY * (n + 1);
+        }
+    }
+}
+
+void HoldString(StringModes& modes, const int string) {
+    std::fill(modes.amplitude.begin() + string * STRING_MODES, modes.amplitude.begin() + (string + 1) * STRING_MODES, 0.0f);
+    std::fill(modes.velocity.begin() + string * STRING_MODES, modes.velocity.begin() + (string + 1) * STRING_MODES, 0.0f);
+    modes.held[string] = 1;
+    modes.moving[string] = 0;
+}
+
+void ReleaseString(StringModes& modes, const int string, const float position, const float displacement) {
+    // Fourier sine series of a triangle with its apex at p: a_n = 2 d sin(n pi p) / (n^2 pi^2 p (1 - p))
+    const float p = std::min(std::max(position, 0.05f), 0.95f);
+    float* a = &modes.amplitude[string * STRING_MODES];
+    float* v = &modes.velocity[string * STRING_MODES];
+    float* shape = &modes.shape[string * STRING_MODES];
+    for (int n = 0; n < STRING_MODES; ++n) {
+        const float k = (n + 1) * PI;
+        shape[n] = sinf(k * p);
+        a[n] = 2.0f * displacement * shape[n] / (k * k * p * (1.0f - p));
+        v[n] = 0.0f;
+    }
+    modes.position[string] = p;
+    modes.previous[string] = displacement;
+    modes.current[string] = displacement;
+    modes.held[string] = 0;
+    modes.moving[string] = 1;
+}
+
+void StepStringModes(StringModes& modes, const int first, const int last) {
+    const float dt = 1.0f / PHYSICS_RATE;
+    float* a = modes.amplitude.data();
+    float* v = modes.velocity.data();
+    const float* omegaSquared = modes.omegaSquared.data();
+    const float* damping = modes.damping.data();
+
+    // Semi-implicit Euler on every mode of every string at once; stable while omega * dt < 2. Held and settled
+    // strings are all zeros and stay that way.
+    for (int i = first * STRING_MODES; i < last * STRING_MODES; ++i) {
+        v[i] += (-omegaSquared[i] * a[i] - damping[i] * v[i]) * dt;
+        a[i] += v[i] * dt;
+    }
+
+    for (int s = first; s < last; ++s) {
+        if (!modes.moving[s]) continue;
+        float displacement = 0.0f;
+        float energy = 0.0f;
+        for (int n = 0; n < STRING_MODES; ++n) {
+            const int i = s * STRING_MODES + n;
+            displacement += a[i] * modes.shape[i];
+            energy = std::max(energy, std::max(fabsf(a[i]), fabsf(v[i]) * dt));
+        }
+        modes.previous[s] = modes.current[s];
+        modes.current[s] = displacement;
+        if (energy < SETTLED) {
+            std::fill(a + s * STRING_MODES, a + (s + 1) * STRING_MODES, 0.0f);
+            std::fill(v + s * STRING_MODES, v + (s + 1) * STRING_MODES, 0.0f);
+            modes.previous[s] = 0.0f;
+            modes.current[s] = 0.0f;
+            modes.moving[s] = 0;
+        }
+    }
+}
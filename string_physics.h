@@ -0,0 +1,42 @@
+#ifndef STRING_PHYSICS_H
+#define STRING_PHYSICS_H
+
+#include <vector>
+
+constexpr int STRING_MODES = 6;             // vibration modes simulated per string
+constexpr float PHYSICS_RATE = 240.0f;      // solver steps per second, independent of the frame rate
+
+// Visible motion of the strings as a sum of damped standing waves, y(x) = sum a_n sin(n pi x). Released from a
+// pulled shape, each mode rings at n times the string's fundamental and decays at a rate growing with n, so the
+// string settles from a kinked triangle into a smooth sway, and a string plucked again while still swinging just
+// has its modes replaced. The fundamentals are slowed down to something the eye can follow, not the audio pitch.
+// State is structure-of-arrays, STRING_MODES floats per string, and one solver step is a single loop over all of
+// them. Everything is sized by InitStringModes, so stepping never allocates.
+struct StringModes {
+    int count = 0;
+    std::vector<float> amplitude;           // a_n in px, count * STRING_MODES
+    std::vector<float> velocity;            // da_n/dt
+    std::vector<float> omegaSquared;        // (2 pi f_n)^2
+    std::vector<float> damping;             // 2 * decay rate of mode n, 1/s
+    std::vector<float> shape;               // sin(n pi x) at the string's observed position
+    std::vector<float> position;            // observed point along the string, 0..1; where it was last plucked
+    std::vector<float> previous;            // displacement at position before and after the latest step, for
+    std::vector<float> current;             // interpolating the rendered frame between solver steps
+    std::vector<unsigned char> held;        // held strings are positioned by the plectrum, not the solver
+    std::vector<unsigned char> moving;      // sounding strings; settled ones are skipped until released again
+};
+
+// fundamentals are the visual vibration frequencies of the strings in Hz, one per string.
+void InitStringModes(StringModes& modes, const std::vector<float>& fundamentals);
+
+// Takes the string out of the solver while something holds it.
+void HoldString(StringModes& modes, int string);
+
+// Lets go of the string pulled into a triangle with its apex displacement px from rest at position (0..1).
+void ReleaseString(StringModes& modes, int string, float position, float displacement);
+
+// Advances strings [first, last) by one 1/PHYSICS_RATE step. Strings never touch each other's state, so disjoint
+// ranges can be stepped on different threads and give the same result as one call over all of them.
+void StepStringModes(StringModes& modes, int first, int last);
+
+#endif //STRING_PHYSICS_H
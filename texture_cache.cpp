@@ -0,0 +1,51 @@
+#include "texture_cache.h"
+#include <tuple>
+
+namespace {
+    enum TextureKind {
+        TEXTURE_GRADIENT,
+        TEXTURE_BLURRED_RECT
+    };
+
+    unsigned int PackColor(const Color color) {
+        return (unsigned int)color.r << 24 | (unsigned int)color.g << 16 | (unsigned int)color.b << 8 | color.a;
+    }
+}
+
+bool TextureCacheKey::operator<(const TextureCacheKey& other) const {
+    return std::tie(kind, width, height, param, colorA, colorB)
+         < std::tie(other.kind, other.width, other.height, other.param, other.colorA, other.colorB);
+}
+
+Texture2D GetCachedGradient(TextureCache& cache, const int width, const int height, const int direction, const Color start, const Color end) {
+    const TextureCacheKey key = {TEXTURE_GRADIENT, width, height, direction, PackColor(start), PackColor(end)};
+    const auto found = cache.textures.find(key);
+    if (found != cache.textures.end()) return found->second;
+
+    const Image grad = GenImageGradientLinear(width, height, direction, start, end);
+    const Texture2D texture = LoadTextureFromImage(grad);
+    UnloadImage(grad);
+    cache.textures[key] = texture;
+    return texture;
+}
+
+Texture2D GetCachedBlurredRect(TextureCache& cache, const int width, const int height, const int blurSize, const float opacity) {
+    const Color color = Fade(BLACK, opacity);
+    const TextureCacheKey key = {TEXTURE_BLURRED_RECT, width, height, blurSize, PackColor(color), 0};
+    const auto found = cache.textures.find(key);
+    if (found != cache.textures.end()) return found->second;
+
+    Image shadow_image = GenImageColor(width, height, color);
+    ImageBlurGaussian(&shadow_image, blurSize);
+    const Texture2D texture = LoadTextureFromImage(shadow_image);
+    UnloadImage(shadow_image);
+    cache.textures[key] = texture;
+    return texture;
+}
+
+void UnloadTextureCache(TextureCache& cache) {
+    for (const auto& entry : cache.textures) {
+        UnloadTexture(entry.second);
+    }
+    cache.textures.clear();
+}
@@ -0,0 +1,29 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include "raylib.h"
+#include <map>
+
+// Procedurally generated textures (UI gradients, blurred shadow rectangles) keyed by the parameters they were
+// generated from. Each one is generated and uploaded the first time it is asked for and reused afterwards.
+// Owned by runGameLoop and released with UnloadTextureCache before the window closes.
+struct TextureCacheKey {
+    int kind;
+    int width;
+    int height;
+    int param;                  // gradient direction or blur radius
+    unsigned int colorA;
+    unsigned int colorB;
+
+    bool operator<(const TextureCacheKey& other) const;
+};
+
+struct TextureCache {
+    std::map<TextureCacheKey, Texture2D> textures;
+};
+
+Texture2D GetCachedGradient(TextureCache& cache, int width, int height, int direction, Color start, Color end);
+Texture2D GetCachedBlurredRect(TextureCache& cache, int width, int height, int blurSize, float opacity);
+void UnloadTextureCache(TextureCache& cache);
+
+#endif //TEXTURE_CACHE_H
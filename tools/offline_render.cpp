@@ -0,0 +1,77 @@
+// Bounces a performance to a WAV file without a window or an audio device. The plucks come from an input recording
+// (DigiHarp --record) run through the headless harp, or from a scripted arpeggio when no recording is given. Pass
+// - as the recording to pick the thread count for the scripted arpeggio.
+// Usage: OfflineRender <out.wav> [recording|-] [threads]
+#include "../harp.h"
+#include "../input_recording.h"
+#include "../job_system.h"
+#include "../offline_render.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+constexpr double SCRIPT_SECONDS = 600.0;
+constexpr double SCRIPT_NOTE_SPACING = 0.125;
+
+// Up and down across every string, one pluck per eighth note at 120 BPM
+std::vector<PluckEvent> ScriptedPlucks() {
+    std::vector<PluckEvent> plucks;
+    const int cycle = 2 * (CHORDS - 1);
+    for (int i = 0; i * SCRIPT_NOTE_SPACING < SCRIPT_SECONDS; ++i) {
+        const int step = i % cycle;
+        const int string = step < CHORDS ? step : cycle - step;
+        plucks.push_back({string, 0.6f + 0.4f * (i % 4 == 0), 0.3f, i * SCRIPT_NOTE_SPACING});
+    }
+    return plucks;
+}
+
+std::vector<PluckEvent> RecordedPlucks(const std::vector<HarpInput>& frames) {
+    Harp harp;
+    addChords(harp, CHORDS);
+    std::vector<PluckEvent> plucks;
+    for (const HarpInput& input : frames) {
+        UpdateHarp(harp, input);
+        plucks.insert(plucks.end(), harp.plucks.begin(), harp.plucks.end());
+    }
+    return plucks;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: OfflineRender <out.wav> [recording|-] [threads]" << std::endl;
+        return 1;
+    }
+    std::vector<PluckEvent> plucks;
+    if (argc > 2 && std::strcmp(argv[2], "-") != 0) {
+        std::vector<HarpInput> frames;
+        if (!LoadInputRecording(argv[2], frames)) {
+            std::cerr << "could not load recording " << argv[2] << std::endl;
+            return 1;
+        }
+        plucks = RecordedPlucks(frames);
+    } else {
+        plucks = ScriptedPlucks();
+    }
+
+    const int threads = argc > 3 ? std::max(1, atoi(argv[3])) : std::max(1u, std::thread::hardware_concurrency());
+    JobSystem jobs(threads);
+    OfflineRenderSettings settings;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!RenderPlucksToWav(argv[1], plucks, settings, &jobs)) {
+        std::cerr << "could not write " << argv[1] << std::endl;
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double length = 0.0;
+    for (const PluckEvent& pluck : plucks) length = std::max(length, pluck.time);
+    length += plucks.empty() ? 0.0 : settings.tailSeconds;
+    std::cout << plucks.size() << " plucks, " << length << " s of audio rendered in " << seconds << " s on "
+              << threads << " thread(s), " << length / seconds << "x real time" << std::endl;
+    return 0;
+}